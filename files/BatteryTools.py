@@ -1,5 +1,10 @@
 from typing import Union
+import concurrent.futures as cf
+from concurrent.futures import ThreadPoolExecutor
 import math
+import os
+
+import numpy as np
 
 import PySAM.Pvsamv1 as PVBatt
 import PySAM.Battery as Batt
@@ -133,8 +138,7 @@ def size_battery(model, desired_power, desired_capacity, desired_voltage, size_b
                        'batt_current_charge_max', 'batt_current_discharge_max', 'batt_power_charge_max_kwac',
                        'batt_power_discharge_max_kwac', 'batt_power_charge_max_kwdc', 'batt_power_discharge_max_kwdc')
 
-    for name in computed_inputs:
-        model.value(name, sizing_outputs[name])
+    model.BatterySystem.assign({name: sizing_outputs[name] for name in computed_inputs})
 
     #
     # calculate thermal
@@ -151,8 +155,7 @@ def size_battery(model, desired_power, desired_capacity, desired_voltage, size_b
 
     thermal_outputs = calculate_thermal_params(thermal_inputs)
 
-    model.value('batt_mass', thermal_outputs['mass'])
-    model.value('batt_surface_area', thermal_outputs['surface_area'])
+    model.BatterySystem.assign({'batt_mass': thermal_outputs['mass'], 'batt_surface_area': thermal_outputs['surface_area']})
 
     return sizing_outputs.update(thermal_outputs)
 
@@ -349,6 +352,119 @@ def calculate_battery_size(input_dict, tol=0.05):
     return output_dict
 
 
+def calculate_battery_sizes(input_dict, tol=0.05):
+    """Vectorized ``calculate_battery_size`` for sizing many battery configurations at once, such as in a design-space sweep.
+    Takes the same inputs, where any value may be a numpy array or list and all arrays are broadcast together.
+    Instead of raising a ValueError when a configuration can't meet its desired capacity within `tol`, the
+    configuration is marked infeasible in the `feasible` output.
+
+    If the battery's original `mass` [kg], `surface_area` [m^2] and `original_capacity` [kWh] are included, and optionally
+    `module_capacity` and `module_surface_area`, the thermal parameters are also sized as in ``calculate_thermal_params``.
+
+    :param dict input_dict: Dictionary of battery parameters as for ``calculate_battery_size``
+    :param float tol: Tolerance of computed capacity relative to desired capacity
+
+    :returns: Dictionary of numpy arrays with the outputs of ``calculate_battery_size``, plus `feasible` (bool) and,
+        if thermal inputs were provided, `batt_mass` and `batt_surface_area`. Apply one configuration with ``apply_battery_size``.
+    :rtype: dict
+    """
+    for k in ('size_by_ac_not_dc', 'batt_ac_or_dc', 'desired_power', 'desired_capacity', 'batt_Qfull',
+              'batt_Vnom_default', 'desired_voltage'):
+        if k not in input_dict:
+            raise ValueError(f"calculate_battery_sizes requires {k}")
+
+    def get(key, default=None):
+        value = input_dict.get(key, default)
+        return None if value is None else np.asarray(value, dtype=float)
+
+    ac_connected = get('batt_ac_or_dc').astype(bool)
+    size_by_ac_not_dc = get('size_by_ac_not_dc').astype(bool)
+    desired_power = get('desired_power')
+    desired_capacity = get('desired_capacity')
+    desired_voltage = get('desired_voltage')
+    batt_Qfull = get('batt_Qfull')
+    batt_Vnom_default = get('batt_Vnom_default')
+
+    # conversion efficiencies, with the same requirements as calculate_battery_size
+    dc_ac_eff = get('batt_dc_ac_efficiency', np.nan) * 0.01
+    inverter_eff = get('inverter_eff', np.nan) * 0.01 * get('batt_dc_dc_efficiency', 100) * 0.01
+    conv_eff = np.where(ac_connected, dc_ac_eff, inverter_eff)
+    if np.any(np.isnan(conv_eff)) or np.any(conv_eff > 1):
+        raise ValueError("Conversion efficiencies must be provided and at most 100")
+
+    capacity = np.where(size_by_ac_not_dc, desired_capacity / conv_eff, desired_capacity)
+    max_rate = desired_power / desired_capacity
+
+    num_series = np.ceil(desired_voltage / batt_Vnom_default)
+    num_strings = np.ceil(capacity * 1000 / (batt_Qfull * batt_Vnom_default * num_series))
+    computed_voltage = batt_Vnom_default * num_series
+    computed_capacity = batt_Qfull * computed_voltage * num_strings * 0.001
+    computed_power = computed_capacity * max_rate
+
+    power_dc = computed_power
+    power_discharge_ac = power_dc * conv_eff
+    power_charge_ac = np.where(size_by_ac_not_dc, power_dc * conv_eff, power_dc / conv_eff)
+    power_charge_dc = np.where(size_by_ac_not_dc, power_dc * conv_eff * conv_eff, power_dc)
+
+    output_dict = {
+        'voltage': computed_voltage,
+        'power': computed_power,
+        'batt_computed_series': num_series.astype(int),
+        'batt_computed_strings': num_strings.astype(int),
+        'batt_computed_bank_capacity': computed_capacity,
+        'time_capacity': computed_capacity / computed_power,
+        'batt_power_discharge_max_kwdc': power_dc,
+        'batt_power_charge_max_kwdc': power_charge_dc,
+        'batt_current_charge_max': power_charge_dc / computed_voltage * 1000,
+        'batt_current_discharge_max': power_dc / computed_voltage * 1000,
+        'batt_power_discharge_max_kwac': power_discharge_ac,
+        'batt_power_charge_max_kwac': power_charge_ac,
+        'feasible': np.abs(computed_capacity - capacity) / capacity <= tol
+    }
+
+    if input_dict.keys() >= {'mass', 'surface_area', 'original_capacity'}:
+        thermal_inputs = {k: get(k) for k in ('mass', 'surface_area', 'original_capacity', 'module_capacity',
+                                              'module_surface_area') if k in input_dict}
+        thermal_inputs['desired_capacity'] = computed_capacity
+        thermal_outputs = calculate_thermal_params(thermal_inputs)
+        output_dict['batt_mass'] = thermal_outputs['mass']
+        output_dict['batt_surface_area'] = thermal_outputs['surface_area']
+
+    shape = np.broadcast(*output_dict.values()).shape
+    return {k: np.broadcast_to(v, shape) for k, v in output_dict.items()}
+
+
+def apply_battery_size(model, sizes, index=0):
+    """Assigns one configuration from ``calculate_battery_sizes`` to a model with a single assign call per group.
+
+    :param model: PySAM.Battery.Battery, PySAM.Pvsamv1.Pvsamv1 or PySAM.BatteryStateful.BatteryStateful
+    :param dict sizes: Output of ``calculate_battery_sizes``
+    :param index: Index of the configuration in the arrays of `sizes`
+    """
+    def value(name):
+        # sizes are 0-d arrays when every input to calculate_battery_sizes is a scalar
+        return np.atleast_1d(sizes[name])[index].item()
+
+    if not value('feasible'):
+        raise ValueError("Could not meet desired battery capacity. Consider adjusting the desired voltage, "
+                         "or battery cell properties")
+
+    if type(model) == Batt.Battery or type(model) == PVBatt.Pvsamv1:
+        names = ('batt_computed_bank_capacity', 'batt_computed_series', 'batt_computed_strings',
+                 'batt_current_charge_max', 'batt_current_discharge_max', 'batt_power_charge_max_kwac',
+                 'batt_power_discharge_max_kwac', 'batt_power_charge_max_kwdc', 'batt_power_discharge_max_kwdc',
+                 'batt_mass', 'batt_surface_area')
+        model.BatterySystem.assign({name: value(name) for name in names if name in sizes})
+    elif type(model) == BattStfl.BatteryStateful:
+        params = {'nominal_voltage': value('voltage'), 'nominal_energy': value('batt_computed_bank_capacity')}
+        if 'batt_mass' in sizes:
+            params['mass'] = value('batt_mass')
+            params['surface_area'] = value('batt_surface_area')
+        model.ParamsPack.assign(params)
+    else:
+        raise TypeError
+
+
 def calculate_thermal_params(input_dict):
     """Calculates the mass and surface area of a battery by calculating from its current parameters the
     mass / specific energy and volume / specific energy ratios. If module_capacity and module_surface_area are provided, battery surface area is calculated by
@@ -479,3 +595,555 @@ def chem_batterystateful(model: BattStfl.BatteryStateful, chem):
             model.value(k, v)
 
     battery_model_sizing(model, -1, original_capacity, original_voltage)
+
+
+_dispatch_inputs = None
+
+
+def _dispatch_worker_init(battery_inputs, utility_inputs):
+    """
+    Stores the shared inputs once per worker process of `compare_dispatch_strategies`
+    """
+    global _dispatch_inputs
+    _dispatch_inputs = (battery_inputs, utility_inputs)
+
+
+def _run_dispatch_strategy(battery_inputs, utility_inputs, strategy):
+    """
+    Runs Battery, and Utilityrate5 on the same data if `utility_inputs` is provided, for one dispatch strategy
+    """
+    model = Batt.new()
+    model.assign(battery_inputs)
+    for name, value in strategy.items():
+        model.value(name, value)
+    model.execute(0)
+
+    capacity_percent = model.Outputs.batt_capacity_percent
+    results = {
+        'cycles': max(model.Outputs.batt_cycles),
+        'capacity_percent_end': capacity_percent[-1],
+        'degradation_percent': 100 - capacity_percent[-1],
+        'discharge_energy': sum(model.Outputs.batt_annual_discharge_energy),
+        'roundtrip_efficiency': model.Outputs.average_battery_roundtrip_efficiency
+    }
+
+    if utility_inputs is not None:
+        import PySAM.Utilityrate5 as Utility
+
+        utility = Utility.from_existing(model)
+        utility.assign(utility_inputs)
+        utility.execute(0)
+        results['bill_w_sys_year1'] = sum(utility.Outputs.year1_monthly_utility_bill_w_sys)
+        results['bill_wo_sys_year1'] = sum(utility.Outputs.year1_monthly_utility_bill_wo_sys)
+        results['savings_year1'] = utility.Outputs.savings_year1
+    return results
+
+
+def _dispatch_worker(strategy):
+    return _run_dispatch_strategy(_dispatch_inputs[0], _dispatch_inputs[1], strategy)
+
+
+def compare_dispatch_strategies(model, strategies, utility_inputs=None, workers=1):
+    """Runs a Battery model once per candidate dispatch strategy and tabulates the results, such as to choose
+    ``batt_dispatch_choice`` and its parameters. All strategies share the model's other inputs, including `gen` and `load`.
+        i.e.
+            strategies = [{'batt_dispatch_choice': 0},
+                          {'batt_dispatch_choice': 0, 'batt_look_ahead_hours': 12},
+                          {'batt_dispatch_choice': 4, 'batt_dispatch_update_frequency_hours': 1}]
+            table = PySAM.BatteryTools.compare_dispatch_strategies(battery, strategies, utility_inputs=ur.export(), workers=3)
+
+    The model's inputs are exported once and sent once to each worker process, which then only receives the strategies.
+
+    :param model: PySAM.Battery.Battery with all inputs assigned
+    :param list strategies: dictionaries of input values by variable name, usually from the BatteryDispatch group, one per strategy
+    :param dict utility_inputs: optional nested dictionary of Utilityrate5 inputs, such as from ``Utilityrate5.export()``.
+        If provided, Utilityrate5 is run on each strategy's results to calculate the first-year bill savings.
+        Its `gen` and `load` are replaced by the Battery model's.
+    :param int workers: Number of worker processes. Default = 1, which runs in this process
+
+    :returns: pandas.DataFrame with one row per strategy, with the strategy's inputs and the columns cycles,
+        capacity_percent_end, degradation_percent, discharge_energy [kWh] and roundtrip_efficiency [%], plus
+        bill_w_sys_year1, bill_wo_sys_year1 and savings_year1 [$] if `utility_inputs` is provided
+    """
+    import pandas as pd
+
+    if type(model) != Batt.Battery:
+        raise TypeError
+
+    battery_inputs = model.export()
+    battery_inputs.pop('Outputs', None)
+    if utility_inputs is not None:
+        utility_inputs = {group: {k: v for k, v in values.items() if k not in ('gen', 'load')}
+                          for group, values in utility_inputs.items() if group != 'Outputs'}
+
+    strategies = list(strategies)
+    if workers == 1:
+        results = [_run_dispatch_strategy(battery_inputs, utility_inputs, strategy) for strategy in strategies]
+    else:
+        with cf.ProcessPoolExecutor(max_workers=workers, initializer=_dispatch_worker_init,
+                                    initargs=(battery_inputs, utility_inputs)) as executor:
+            results = list(executor.map(_dispatch_worker, strategies))
+
+    return pd.DataFrame([dict(strategy, **result) for strategy, result in zip(strategies, results)])
+
+
+class BatteryStatefulFleet:
+    """Fleet of BatteryStateful models stepped together, such as the residential batteries of a virtual power plant.
+    Each battery keeps its own ParamsCell, ParamsPack and state, while the fleet's commands and states are numpy arrays
+    with one entry per battery (structure-of-arrays). Each call to ``step`` advances every battery by one timestep,
+    splitting the fleet into chunks that run on a thread pool. Each chunk is one ``BatteryStateful.step_models`` call,
+    which runs all of the chunk's batteries with the GIL released and writes their states into the fleet's arrays,
+    so the chunks run on separate cores.
+
+    :param models: list of BatteryStateful models. Models are ``setup()`` by the fleet, so state assigned before then is the initial state.
+    :param int, optional workers: number of threads, default os.cpu_count()
+    :param int, optional control_mode: 0 for current commands [A], 1 for power commands [kW]
+    """
+
+    state_names = ('SOC', 'P', 'I', 'V', 'T_batt', 'Q_max')
+
+    def __init__(self, models, workers=None, control_mode=1):
+        self.models = list(models)
+        self.control_mode = control_mode
+        self.workers = max(1, min(workers or os.cpu_count() or 1, len(self.models)))
+        for model in self.models:
+            model.Controls.control_mode = control_mode
+            model.setup()
+
+        bounds = np.linspace(0, len(self.models), self.workers + 1).astype(int)
+        self._chunks = [(bounds[i], bounds[i + 1]) for i in range(self.workers) if bounds[i] < bounds[i + 1]]
+        self._executor = ThreadPoolExecutor(max_workers=self.workers) if self.workers > 1 else None
+
+        for name in self.state_names:
+            setattr(self, name, np.array([model.value(name) for model in self.models], dtype=float))
+
+    @classmethod
+    def from_dicts(cls, inputs, workers=None, control_mode=1):
+        """
+        Create a fleet from a list of nested dictionaries of BatteryStateful inputs, as from ``BatteryStateful.export()``
+
+        :param inputs: list of dict, one per battery
+        :param int, optional workers: number of threads, default os.cpu_count()
+        :param int, optional control_mode: 0 for current commands [A], 1 for power commands [kW]
+        """
+        models = []
+        for battery_inputs in inputs:
+            model = BattStfl.new()
+            model.assign(battery_inputs)
+            models.append(model)
+        return cls(models, workers, control_mode)
+
+    def __len__(self):
+        return len(self.models)
+
+    def _run_chunk(self, start, end, commands):
+        BattStfl.step_models(self.models[start:end], commands[start:end],
+                             [getattr(self, name)[start:end] for name in self.state_names], self.control_mode)
+
+    def _run(self, commands):
+        if self._executor is None:
+            self._run_chunk(0, len(self.models), commands)
+            return
+        futures = [self._executor.submit(self._run_chunk, start, end, commands) for start, end in self._chunks]
+        for future in futures:
+            future.result()
+
+    def step(self, commands):
+        """
+        Advance every battery one timestep
+
+        :param commands: array of length N of power [kW] or current [A] per battery, by control_mode. Positive is discharging
+        :return: dict of state arrays of length N: SOC, P, I, V, T_batt and Q_max
+        """
+        commands = np.asarray(commands, dtype=float)
+        if commands.shape != (len(self.models),):
+            raise ValueError(f"commands must have length {len(self.models)}")
+        self._run(np.ascontiguousarray(commands.reshape(-1, 1)))
+        return self.states()
+
+    def run(self, commands):
+        """
+        Advance every battery through a schedule of commands known in advance. Each chunk of batteries runs its whole
+        schedule in one ``step_models`` call, which is faster than calling ``step`` once per timestep.
+
+        :param commands: array of shape (N, number of timesteps) of power [kW] or current [A] per battery
+        :return: dict of state arrays of length N after the last timestep
+        """
+        commands = np.ascontiguousarray(commands, dtype=float)
+        if commands.ndim != 2 or commands.shape[0] != len(self.models):
+            raise ValueError(f"commands must have shape ({len(self.models)}, number of timesteps)")
+        self._run(commands)
+        return self.states()
+
+    def states(self):
+        """
+        :return: dict of state arrays of length N: SOC, P, I, V, T_batt and Q_max
+        """
+        return {name: getattr(self, name) for name in self.state_names}
+
+    def close(self):
+        """Shut down the fleet's thread pool"""
+        if self._executor is not None:
+            self._executor.shutdown()
+            self._executor = None
+
+
+class BatteryStatefulLifetime:
+    """Year-by-year lifetime simulation of a BatteryStateful model that saves the battery state at the end of every year,
+    including cycle counts, capacity fade and thermal state, with ``BatteryStateful.snapshot``. Later runs resume from the
+    latest saved year they have in common with an earlier run, so variants that only extend the number of years or change
+    replacements in later years re-simulate only the years after the common prefix.
+        i.e.
+            lifetime = PySAM.BatteryTools.BatteryStatefulLifetime(model, year_power)
+            base = lifetime.run(20)
+            extended = lifetime.run(25)  # simulates years 21-25 only
+            replaced = lifetime.run(25, [0] * 14 + [50])  # resumes from the end of year 14
+
+    The Battery and Pvsamv1 compute modules always simulate the lifetime from the first year and can't be resumed,
+    so this uses BatteryStateful with the battery's dispatch given as a one-year command profile repeated every year.
+
+    :param model: PySAM.BatteryStateful.BatteryStateful with its parameters and initial state assigned
+    :param year_commands: one year of power [kW] or current [A] commands, by control_mode, at the model's dt_hr
+    :param int, optional control_mode: 0 for current commands [A], 1 for power commands [kW]
+    """
+
+    def __init__(self, model, year_commands, control_mode=1):
+        if type(model) != BattStfl.BatteryStateful:
+            raise TypeError
+        self.model = model
+        self.year_commands = np.ascontiguousarray(year_commands, dtype=float)
+        self.control_mode = control_mode
+        self.replacement_option = int(model.ParamsPack.replacement_option)
+        model.Controls.control_mode = control_mode
+        model.setup()
+        self._initial = model.snapshot()
+        self._checkpoints = dict()
+        self._schedule = None
+        self.years_simulated = 0
+
+    def _key(self, schedule, year):
+        # results to the end of `year` depend only on replacements in the years up to then
+        return tuple(schedule[:year])
+
+    def run(self, years, replacement_schedule_percent=None):
+        """
+        Simulate `years` years, resuming from the latest saved year-end state shared with an earlier run
+
+        :param int years: number of years
+        :param list replacement_schedule_percent: optional percentage of capacity to replace in each year,
+            if the model's ParamsPack.replacement_option is 2. Years beyond the list have no replacements
+        :return: dict of arrays with one value per year: capacity_percent (StateCell.q_relative),
+            n_cycles, n_replacements and SOC at the end of each year
+        """
+        schedule = [0.0] * years
+        if self.replacement_option == 2:
+            if replacement_schedule_percent is None:
+                replacement_schedule_percent = self.model.ParamsPack.replacement_schedule_percent
+            for i, percent in enumerate(replacement_schedule_percent[:years]):
+                schedule[i] = float(percent)
+        elif replacement_schedule_percent is not None:
+            raise ValueError("replacement_schedule_percent requires ParamsPack.replacement_option = 2")
+
+        start = years
+        while start > 0 and self._key(schedule, start) not in self._checkpoints:
+            start -= 1
+
+        # the replacement schedule is read by setup, so it's only set up again when the schedule changes
+        if self.replacement_option == 2 and schedule != self._schedule:
+            self.model.ParamsPack.replacement_schedule_percent = schedule
+            self.model.setup()
+            self._schedule = schedule
+        self.model.restore(self._checkpoints[self._key(schedule, start)][0] if start else self._initial)
+
+        for year in range(start, years):
+            self.model.run_steps(self.year_commands, self.control_mode)
+            year_end = {
+                'capacity_percent': self.model.StateCell.q_relative,
+                'n_cycles': self.model.StateCell.n_cycles,
+                'n_replacements': self.model.StatePack.n_replacements,
+                'SOC': self.model.StatePack.SOC
+            }
+            self._checkpoints[self._key(schedule, year + 1)] = (self.model.snapshot(), year_end)
+            self.years_simulated += 1
+
+        year_ends = [self._checkpoints[self._key(schedule, year + 1)][1] for year in range(years)]
+        return {name: np.array([year_end[name] for year_end in year_ends]) for name in
+                ('capacity_percent', 'n_cycles', 'n_replacements', 'SOC')}
+
+    def clear(self):
+        """Discard the saved year-end states"""
+        self._checkpoints.clear()
+
+
+def _degradation_worker(job):
+    """
+    Cycles a BatteryStateful model once a day at one depth of discharge and room temperature, returning the
+    capacity [%] at the end of each day. Runs inside a worker process of `fit_degradation_surrogate`
+    """
+    inputs, dod, temperature, days = job
+    model = BattStfl.new()
+    model.assign(inputs)
+    model.Controls.control_mode = 1
+    model.ParamsPack.T_room_init = temperature
+    model.ParamsCell.minimum_SOC = 50 - dod / 2
+    model.ParamsCell.maximum_SOC = 50 + dod / 2
+    model.ParamsCell.initial_SOC = 50 + dod / 2
+    model.setup()
+
+    steps_per_day = int(round(24 / model.Controls.dt_hr))
+    half_cycle = max(1, steps_per_day // 6)
+    power = model.ParamsPack.nominal_energy * dod / 100 / (half_cycle * model.Controls.dt_hr) * 1.2
+    day_commands = np.zeros(steps_per_day)
+    day_commands[:half_cycle] = power
+    day_commands[steps_per_day // 2:steps_per_day // 2 + half_cycle] = -power
+
+    capacity = np.empty(days)
+    for day in range(days):
+        model.run_steps(day_commands, 1)
+        capacity[day] = model.StateCell.q_relative
+    return capacity
+
+
+def _degradation_history_worker(job):
+    """
+    Cycles a BatteryStateful model once a day with a different depth of discharge and room temperature each day,
+    returning the capacity [%] at the end of each day and the measured range of state of charge of each day.
+    Runs inside a worker process of `fit_degradation_surrogate` for validation
+    """
+    inputs, day_dods, day_temperatures = job
+    model = BattStfl.new()
+    model.assign(inputs)
+    model.Controls.control_mode = 1
+    max_dod = max(day_dods)
+    model.ParamsPack.T_room_init = day_temperatures[0]
+    model.ParamsCell.minimum_SOC = 50 - max_dod / 2
+    model.ParamsCell.maximum_SOC = 50 + max_dod / 2
+    model.ParamsCell.initial_SOC = 50 + max_dod / 2
+    model.setup()
+
+    steps_per_day = int(round(24 / model.Controls.dt_hr))
+    half_cycle = max(1, steps_per_day // 6)
+    capacity = np.empty(len(day_dods))
+    measured_dods = np.empty(len(day_dods))
+    for day, (dod, temperature) in enumerate(zip(day_dods, day_temperatures)):
+        power = model.ParamsPack.nominal_energy * dod / 100 / (half_cycle * model.Controls.dt_hr)
+        day_commands = np.zeros(steps_per_day)
+        day_commands[:half_cycle] = power
+        day_commands[steps_per_day // 2:steps_per_day // 2 + half_cycle] = -power * 1.2
+        model.StatePack.T_room = temperature
+        soc = np.asarray(model.run_steps(day_commands, 1)['SOC'])
+        capacity[day] = model.StateCell.q_relative
+        measured_dods[day] = soc.max() - soc.min()
+    return capacity, measured_dods
+
+
+class BatteryDegradationSurrogate:
+    """Fast capacity fade model fitted from BatteryStateful cycling runs by ``fit_degradation_surrogate``.
+    At each fitted depth of discharge and temperature, capacity loss after `t` days of one cycle per day is
+    a * sqrt(t) + b * t, for the calendar and cycling fade. Coefficients are interpolated linearly between fitted points
+    and held constant outside them. A mix of daily conditions uses the mean of their coefficients.
+
+    The error bound holds within its domain: daily depths of discharge and room temperatures within the fitted ranges,
+    for up to `days` days. Outside it, such as for lifetimes longer than the fitting runs, it is extrapolated and
+    ``in_domain`` is False.
+
+    :param dods: fitted depths of discharge [%], increasing
+    :param temperatures: fitted room temperatures [C], increasing
+    :param coefficients: array of shape (len(dods), len(temperatures), 2) of (a, b)
+    :param float fit_error: largest difference in capacity [%] between the surrogate and the BatteryStateful runs,
+        over the fit residuals and leave-one-out interpolation between fitted depths of discharge and between fitted
+        temperatures
+    :param float validation_error: largest difference in capacity [%] between the surrogate and held-out
+        BatteryStateful runs whose depth of discharge and room temperature change every day within the fitted ranges,
+        at every day of the runs
+    :param int days: number of days each fitting and validation run simulated
+    """
+
+    def __init__(self, dods, temperatures, coefficients, fit_error, validation_error, days):
+        self.dods = np.asarray(dods, dtype=float)
+        self.temperatures = np.asarray(temperatures, dtype=float)
+        self.coefficients = np.asarray(coefficients, dtype=float)
+        self.fit_error = fit_error
+        self.validation_error = validation_error
+        self.days = days
+
+    @property
+    def error_bound(self):
+        """
+        Largest difference in capacity [%] from BatteryStateful within the domain of the surrogate, the larger of
+        ``fit_error`` and ``validation_error``
+        """
+        return max(self.fit_error, self.validation_error)
+
+    def in_domain(self, days, dod, temperature):
+        """
+        True if a duration and all of the daily conditions are within the domain of the error bound
+
+        :param days: number of days, scalar or array
+        :param dod: depth of discharge [%] of the daily cycle, scalar or array of conditions
+        :param temperature: room temperature [C], scalar or array of conditions
+        """
+        dod = np.asarray(dod, dtype=float)
+        temperature = np.asarray(temperature, dtype=float)
+        return bool(np.max(days) <= self.days
+                    and dod.min() >= self.dods[0] and dod.max() <= self.dods[-1]
+                    and temperature.min() >= self.temperatures[0] and temperature.max() <= self.temperatures[-1])
+
+    def _interp_coefficients(self, dod, temperature):
+        dod = np.atleast_1d(np.asarray(dod, dtype=float))
+        temperature = np.broadcast_to(np.asarray(temperature, dtype=float), dod.shape)
+        by_temperature = np.empty((len(self.dods), len(dod), 2))
+        for i in range(len(self.dods)):
+            for k in range(2):
+                by_temperature[i, :, k] = np.interp(temperature, self.temperatures, self.coefficients[i, :, k])
+        result = np.empty((len(dod), 2))
+        for j in range(len(dod)):
+            for k in range(2):
+                result[j, k] = np.interp(dod[j], self.dods, by_temperature[:, j, k])
+        return result
+
+    def capacity_percent(self, days, dod, temperature, weights=None):
+        """
+        Capacity [%] after `days` of daily cycles, for one operating condition or a mix of conditions
+
+        :param days: number of days, scalar or array
+        :param dod: depth of discharge [%] of the daily cycle, scalar or array of conditions
+        :param temperature: room temperature [C], scalar or array of conditions
+        :param weights: optional fraction of days at each condition, default equal
+        :return: capacity [%] with the shape of `days`
+        """
+        coefficients = self._interp_coefficients(dod, temperature)
+        weights = np.ones(len(coefficients)) if weights is None else np.asarray(weights, dtype=float)
+        a, b = weights @ coefficients / weights.sum()
+        days = np.asarray(days, dtype=float)
+        return 100 - a * np.sqrt(days) - b * days
+
+    def capacity_from_timeseries(self, soc, temperature, steps_per_hour, years):
+        """
+        Capacity [%] at the end of each year from one year of battery state of charge and room temperature,
+        such as ``batt_SOC`` from a Battery simulation and its ``batt_room_temperature_celsius``, using each day's
+        range of state of charge as its depth of discharge and each day's mean room temperature. The surrogate is
+        fitted on room temperature, so the battery's own ``batt_temperature`` doesn't apply
+
+        :param soc: one year of state of charge [%]
+        :param temperature: one year of room temperature [C]
+        :param int steps_per_hour: steps per hour of `soc` and `temperature`
+        :param int years: number of years
+        :return: numpy array of capacity [%] at the end of each year
+        """
+        steps_per_day = int(24 * steps_per_hour)
+        n_days = len(soc) // steps_per_day
+        soc = np.asarray(soc, dtype=float)[:n_days * steps_per_day].reshape(n_days, steps_per_day)
+        temperature = np.asarray(temperature, dtype=float)[:n_days * steps_per_day].reshape(n_days, steps_per_day)
+        dod = soc.max(axis=1) - soc.min(axis=1)
+        return self.capacity_percent(np.arange(1, years + 1) * 365, dod, temperature.mean(axis=1))
+
+
+def fit_degradation_surrogate(model, dods=(20, 50, 80, 100), temperatures=(15, 25, 35), days=365, workers=1,
+                              validation_runs=4, seed=0):
+    """Fits a ``BatteryDegradationSurrogate`` to a BatteryStateful model's lifetime model by cycling copies of it
+    once a day at each combination of depth of discharge and room temperature, then validates it against held-out
+    runs whose depth of discharge and room temperature are drawn at random within the fitted ranges every day.
+    Runs are independent and can be spread across worker processes.
+
+    :param model: PySAM.BatteryStateful.BatteryStateful with ParamsCell and ParamsPack assigned, including life_model
+    :param dods: depths of discharge [%] to fit, at least two
+    :param temperatures: room temperatures [C] to fit
+    :param int days: days to simulate per run. The error bound holds up to this duration
+    :param int workers: Number of worker processes. Default = 1, which runs in this process
+    :param int validation_runs: number of held-out runs with mixed daily conditions. Default = 4
+    :param int seed: seed of the random daily conditions of the validation runs
+
+    :returns: BatteryDegradationSurrogate
+    """
+    if type(model) != BattStfl.BatteryStateful:
+        raise TypeError
+    dods = sorted(dods)
+    temperatures = sorted(temperatures)
+    inputs = {group: values for group, values in model.export().items() if group in ('Controls', 'ParamsCell', 'ParamsPack')}
+
+    jobs = [(inputs, dod, temperature, days) for dod in dods for temperature in temperatures]
+    rng = np.random.default_rng(seed)
+    validation_jobs = [(inputs, rng.uniform(dods[0], dods[-1], days), rng.uniform(temperatures[0], temperatures[-1], days))
+                       for _ in range(validation_runs)]
+    if workers == 1:
+        runs = [_degradation_worker(job) for job in jobs]
+        histories = [_degradation_history_worker(job) for job in validation_jobs]
+    else:
+        with cf.ProcessPoolExecutor(max_workers=workers) as executor:
+            runs = list(executor.map(_degradation_worker, jobs))
+            histories = list(executor.map(_degradation_history_worker, validation_jobs))
+    runs = np.array(runs).reshape(len(dods), len(temperatures), days)
+
+    t = np.arange(1, days + 1, dtype=float)
+    features = np.column_stack((np.sqrt(t), t))
+    loss = 100 - runs
+    coefficients = np.empty((len(dods), len(temperatures), 2))
+    for i in range(len(dods)):
+        for j in range(len(temperatures)):
+            coefficients[i, j] = np.linalg.lstsq(features, loss[i, j], rcond=None)[0]
+    error = np.max(np.abs(features @ coefficients.reshape(-1, 2).T - loss.reshape(-1, days).T))
+
+    # interpolation error: predict each interior depth of discharge and temperature from its neighbors
+    for i in range(1, len(dods) - 1):
+        w = (dods[i] - dods[i - 1]) / (dods[i + 1] - dods[i - 1])
+        interpolated = (1 - w) * coefficients[i - 1] + w * coefficients[i + 1]
+        error = max(error, np.max(np.abs(interpolated @ features.T - loss[i])))
+    for j in range(1, len(temperatures) - 1):
+        w = (temperatures[j] - temperatures[j - 1]) / (temperatures[j + 1] - temperatures[j - 1])
+        interpolated = (1 - w) * coefficients[:, j - 1] + w * coefficients[:, j + 1]
+        error = max(error, np.max(np.abs(interpolated @ features.T - loss[:, j])))
+
+    surrogate = BatteryDegradationSurrogate(dods, temperatures, coefficients, float(error), 0., days)
+
+    # validation error: predict each day of the held-out runs from the measured depths of discharge and the room
+    # temperatures of the days up to it, as capacity_from_timeseries does for a simulated year
+    validation_error = 0.
+    for (_, _, day_temperatures), (capacity, measured_dods) in zip(validation_jobs, histories):
+        day_coefficients = surrogate._interp_coefficients(measured_dods, day_temperatures)
+        a, b = (np.cumsum(day_coefficients, axis=0) / t[:, None]).T
+        validation_error = max(validation_error, float(np.max(np.abs(100 - a * np.sqrt(t) - b * t - capacity))))
+    surrogate.validation_error = validation_error
+    return surrogate
+
+
+def estimate_capacity_fade(model, surrogate, years):
+    """Estimates a Battery or Pvsamv1 model's capacity at the end of each year of a lifetime from the results of its
+    first year and a fitted surrogate, instead of simulating every year with ``system_use_lifetime_output = 1``.
+    This post-processes the first year's results; the model is only run if it has no results.
+    Daily depths of discharge come from ``batt_SOC`` and daily temperatures from ``batt_room_temperature_celsius``, the
+    temperature the surrogate was fitted on.
+
+    The surrogate's ``error_bound`` applies to the years within its fitted days, when ``in_domain`` is True. For
+    later years and conditions outside the fitted ranges, the estimate is extrapolated.
+
+    :param model: PySAM.Battery.Battery or PySAM.Pvsamv1.Pvsamv1
+    :param surrogate: BatteryDegradationSurrogate fitted to the model's battery chemistry
+    :param int years: number of years
+
+    :returns: Dictionary {capacity_percent (numpy array), error_bound (float), in_domain (numpy array of bool per year)}
+    """
+    if type(model) != Batt.Battery and type(model) != PVBatt.Pvsamv1:
+        raise TypeError
+    try:
+        soc = model.Outputs.batt_SOC
+    except Exception:
+        model.execute(0)
+        soc = model.Outputs.batt_SOC
+    steps_per_hour = max(1, int(round(len(soc) / 8760)))
+    if int(model.value('system_use_lifetime_output')):
+        steps_per_hour = max(1, int(round(len(soc) / 8760 / model.value('analysis_period'))))
+    year_steps = 8760 * steps_per_hour
+    # room temperature has one value, or one per weather file record, which may differ from the battery time step
+    room = np.asarray(model.value('batt_room_temperature_celsius'), dtype=float)
+    temperature = room[np.arange(year_steps) * len(room) // year_steps]
+
+    soc = np.asarray(soc, dtype=float)[:year_steps]
+    day_soc = soc.reshape(-1, 24 * steps_per_hour)
+    day_dods = day_soc.max(axis=1) - day_soc.min(axis=1)
+    day_temperatures = temperature.reshape(-1, 24 * steps_per_hour).mean(axis=1)
+    return {
+        'capacity_percent': surrogate.capacity_from_timeseries(soc, temperature, steps_per_hour, years),
+        'error_bound': surrogate.error_bound,
+        'in_domain': np.array([surrogate.in_domain(year * 365, day_dods, day_temperatures) for year in range(1, years + 1)])
+    }
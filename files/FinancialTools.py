@@ -0,0 +1,50 @@
+import numpy as np
+from concurrent.futures import ThreadPoolExecutor
+
+from PySAM.PySSC import PySSC
+import PySAM.Merchantplant as mp
+
+
+price_path_outputs = ('project_return_aftertax_npv', 'project_return_aftertax_irr', 'min_dscr', 'debt_fraction', 'lcoe_real')
+
+
+def _copy_model(module, model):
+    """
+    New model of the same module with a copy of the data of `model`
+    """
+    copy = module.new()
+    PySSC().data_deep_copy(model.get_data_ptr(), copy.get_data_ptr())
+    return copy
+
+
+def evaluate_price_paths(model, prices, outputs=price_path_outputs, workers=1, name='mp_energy_market_revenue_single'):
+    """
+    Distributions of Merchantplant results over many market price paths, such as stochastic price scenarios for risk analysis.
+    Every path shares all other inputs of `model`, which is copied once per worker, and the paths are split across workers
+    running `Merchantplant.evaluate_price_paths` on threads.
+
+    :param model: PySAM.Merchantplant.Merchantplant with all inputs assigned and the revenue from `name` enabled
+    :param prices: matrix of one price path [$/MWh] per row, at the time steps of `name`
+    :param outputs: names of number outputs
+    :param int workers: number of threads
+    :param str name: single-column price input, 'mp_energy_market_revenue_single' or 'mp_ancserv1_revenue_single' to 'mp_ancserv4_revenue_single'
+    :return: dict of output name to numpy array with one value per path
+    """
+    if type(model) != mp.Merchantplant:
+        raise TypeError
+    prices = np.ascontiguousarray(prices, dtype=float)
+    if prices.ndim != 2:
+        raise ValueError("prices must be a matrix with one price path per row")
+    outputs = list(outputs)
+
+    workers = max(1, min(workers, len(prices)))
+    if workers == 1:
+        results = model.evaluate_price_paths(prices, outputs, name)
+        return {k: np.asarray(v) for k, v in results.items()}
+
+    chunks = np.array_split(prices, workers)
+    models = [_copy_model(mp, model) for _ in range(workers)]
+    with ThreadPoolExecutor(max_workers=workers) as executor:
+        results = list(executor.map(lambda args: args[0].evaluate_price_paths(np.ascontiguousarray(args[1]), outputs, name),
+                                    zip(models, chunks)))
+    return {k: np.concatenate([np.asarray(r[k]) for r in results]) for k in outputs}
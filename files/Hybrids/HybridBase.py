@@ -5,6 +5,8 @@ from PySAM.PySSC import PySSC
 import marshal
 from ctypes import *
 
+import PySAM.DataTables as tables
+
 import PySAM.Grid as grid
 import PySAM.Singleowner as so
 import PySAM.HostDeveloper as hd 
@@ -19,12 +21,16 @@ class HybridGenerator:
     The PySAM model contains the simulation data for the hybrid simulation, which are modified simlarly to how they are for PySAM
     modules: `value`, `assign`, direct access, and `export`.
 
-    The subsystem model data is copied to and from the HybridSystem during execution.
+    The subsystem model data is copied to the HybridSystem during execution, and its results are copied back after it.
+    A model whose inputs are unchanged since the last execution, by a fingerprint of its data without the results of its
+    compute module, is not copied again.
     """
     _ssc: PySSC = PySSC()
     _ssc.pdll.ssc_data_get_table.restype = c_void_p
     _ssc.pdll.ssc_data_create.restype = c_void_p
     _ssc.pdll.ssc_var_get_number.restype = POINTER(c_float)
+    # names of the INPUT and the OUTPUT variables of each compute module
+    _cmod_vars = dict()
     
     def __init__(self, pysam_module, name) -> None:
         # create the system cmod and the required financial stuff
@@ -35,6 +41,10 @@ class HybridGenerator:
         self._data = None
         # Pointer to the simulation data container inside the PySAM model
         self._data_ptr = None
+        # Pointer to this sub-system's simulation data inside the hybrid input data after an execute
+        self._hybrid_data_ptr = None
+        # Fingerprint of the simulation data inside the hybrid input data after an execute, without results
+        self._fingerprint = None
 
     def new(self):
         if self._data != None:
@@ -60,24 +70,70 @@ class HybridGenerator:
         for k, v in defaults['HybridCosts'].items():
             self.__setattr__(k, v)
 
+    def _module_vars(self):
+        """
+        Names of the INPUT and of the OUTPUT variables of this sub-system's compute module. INOUT variables are in neither
+        """
+        name = self._name
+        if name not in HybridGenerator._cmod_vars:
+            inputs = set()
+            results = set()
+            cmod = self._ssc.module_create(name.encode("ascii"))
+            i = 0
+            while cmod:
+                info = self._ssc.module_var_info(cmod, i)
+                if not info:
+                    break
+                var_type = self._ssc.info_var_type(info)
+                if var_type == self._ssc.INPUT:
+                    inputs.add(self._ssc.info_name(info).decode("ascii"))
+                elif var_type == self._ssc.OUTPUT:
+                    results.add(self._ssc.info_name(info).decode("ascii"))
+                i += 1
+            if cmod:
+                self._ssc.module_free(cmod)
+            HybridGenerator._cmod_vars[name] = (frozenset(inputs), frozenset(results))
+        return HybridGenerator._cmod_vars[name]
+
     def _collect_inputs(self, hybrid_input_data_ptr):
         """
         Insert the simulation data from this technology model as input into the hybrid input data.
         Hybrid input data makes a copy of the simulation data. 
         PySAM model still has data ownership of original simulation data
+
+        If the simulation data without results has the same fingerprint as the copy in the hybrid input data after the
+        last execute, including changes made through variable groups held from earlier, nothing is copied
         """
-        self._ssc.data_set_table(hybrid_input_data_ptr, self._name.encode("ascii"), self._data_ptr)
+        name = self._name
+        fingerprint = tables.fingerprint(self._data_ptr, exclude=self._module_vars()[1])
+        if self._hybrid_data_ptr is not None and fingerprint == self._fingerprint \
+                and tables.get_table(hybrid_input_data_ptr, name) == self._hybrid_data_ptr:
+            return
+        self._hybrid_data_ptr = None
+        tables.set_table(hybrid_input_data_ptr, name, self._data_ptr)
 
     def _collect_outputs(self, hybrid_input_data_ptr):
         """
         Function should only be called after `_collect_inputs` has been called. 
 
-        Get the updated simulation data from the hybrid input data, now with results, and copy it
+        Copy everything but the INPUT variables from the updated simulation data in the hybrid input data into this model,
+        so results are current through any variable group, and keep a reference to it for the next execute. If the
+        compute module changed an INPUT variable, the fingerprints differ and the data is copied again on the next execute
         """
-        p_pv_ret = self._ssc.data_get_table(hybrid_input_data_ptr, self._name.encode("ascii"))
+        p_pv_ret = tables.get_table(hybrid_input_data_ptr, self._name)
         if not p_pv_ret:
             raise RuntimeError(f"Outputs for {self._name} sub-system does not exist in `hybrid_input_data_ptr`")
-        self._ssc.data_deep_copy(p_pv_ret, self._data_ptr)
+        inputs, results = self._module_vars()
+        tables.copy_entries(p_pv_ret, self._data_ptr, exclude=inputs)
+        self._fingerprint = tables.fingerprint(p_pv_ret, exclude=results)
+        self._hybrid_data_ptr = p_pv_ret
+
+    def _discard_hybrid_data(self):
+        """
+        Forget the simulation data in the hybrid input data, such as after a failed execute, so it is copied again on the
+        next execute
+        """
+        self._hybrid_data_ptr = None
 
     def __getattr__(self, name: str):
         if name in self.__dir__():
@@ -138,93 +194,93 @@ class HybridGenerator:
         """
         Total installed cost for technology [$]
         """
-        return self._ssc.data_get_number(self._data_ptr, b'total_installed_cost')
+        return tables.get_number(self._data_ptr, 'total_installed_cost')
     
     @total_installed_cost.setter
     def total_installed_cost(self, total_installed_cost: float):
-        self._ssc.data_set_number(self._data_ptr, b'total_installed_cost', total_installed_cost)
+        tables.set_number(self._data_ptr, 'total_installed_cost', total_installed_cost)
 
     @property
     def om_fixed(self):
         """
         Fixed O&M annual amount [$/year]
         """
-        return self._ssc.data_get_array(self._data_ptr, b'om_fixed')
+        return tables.get_array(self._data_ptr, 'om_fixed')
     
     @om_fixed.setter
     def om_fixed(self, om_fixed: Iterable):
         if not isinstance(om_fixed, Iterable):
             om_fixed = [om_fixed]
-        self._ssc.data_set_array(self._data_ptr, b'om_fixed', om_fixed)
+        tables.set_array(self._data_ptr, 'om_fixed', om_fixed)
 
     @property
     def om_fixed_escal(self):
         """
         Fixed O&M escalation [%/year]
         """
-        return self._ssc.data_get_number(self._data_ptr, b'om_fixed_escal')
+        return tables.get_number(self._data_ptr, 'om_fixed_escal')
     
     @om_fixed_escal.setter
     def om_fixed_escal(self, om_fixed_escal: float):
-        self._ssc.data_set_number(self._data_ptr, b'om_fixed_escal', om_fixed_escal)
+        tables.set_number(self._data_ptr, 'om_fixed_escal', om_fixed_escal)
 
     @property
     def om_production(self):
         """
         Production-based O&M amount [$/MWh]
         """
-        return self._ssc.data_get_array(self._data_ptr, b'om_production')
+        return tables.get_array(self._data_ptr, 'om_production')
     
     @om_production.setter
     def om_production(self, om_production: Iterable):
         if not isinstance(om_production, Iterable):
             om_production = [om_production]
-        self._ssc.data_set_array(self._data_ptr, b'om_production', om_production)
+        tables.set_array(self._data_ptr, 'om_production', om_production)
 
     @property
     def om_production_escal(self):
         """
         Production-based O&M escalation [%/year]
         """
-        return self._ssc.data_get_number(self._data_ptr, b'om_production_escal')
+        return tables.get_number(self._data_ptr, 'om_production_escal')
     
     @om_production_escal.setter
     def om_production_escal(self, om_production_escal: float):
-        self._ssc.data_set_number(self._data_ptr, b'om_production_escal', om_production_escal)
+        tables.set_number(self._data_ptr, 'om_production_escal', om_production_escal)
 
     @property
     def om_capacity(self):
         """
         Capacity-based O&M amount [$/kWcap]
         """
-        return self._ssc.data_get_array(self._data_ptr, b'om_capacity')
+        return tables.get_array(self._data_ptr, 'om_capacity')
     
-    @om_fixed.setter
+    @om_capacity.setter
     def om_capacity(self, om_capacity: Iterable):
         if not isinstance(om_capacity, Iterable):
             om_capacity = [om_capacity]
-        self._ssc.data_set_array(self._data_ptr, b'om_capacity', om_capacity)
+        tables.set_array(self._data_ptr, 'om_capacity', om_capacity)
 
     @property
     def om_capacity_escal(self):
         """
         Capacity-based O&M escalation [%/year]
         """
-        return self._ssc.data_get_number(self._data_ptr, b'om_capacity_escal')
+        return tables.get_number(self._data_ptr, 'om_capacity_escal')
     
     @om_capacity_escal.setter
     def om_capacity_escal(self, om_capacity_escal: float):
-        self._ssc.data_set_number(self._data_ptr, b'om_capacity_escal', om_capacity_escal)
+        tables.set_number(self._data_ptr, 'om_capacity_escal', om_capacity_escal)
 
     @property
     def degradation(self):
         """
         Annual AC degradation [%/yr]. If not provided, defaults to [0]
         """
-        return self._ssc.data_get_array(self._data_ptr, b'degradation')
+        return tables.get_array(self._data_ptr, 'degradation')
     
     @degradation.setter
     def degradation(self, degradation: Iterable):
         if not isinstance(degradation, Iterable):
-            om_capacity = [om_capacity]
-        self._ssc.data_set_array(self._data_ptr, b'degradation', degradation)
+            degradation = [degradation]
+        tables.set_array(self._data_ptr, 'degradation', degradation)
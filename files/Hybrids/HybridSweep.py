@@ -0,0 +1,226 @@
+from concurrent.futures import ThreadPoolExecutor
+
+from .HybridBase import HybridGenerator
+from .HybridSystem import HybridSystem
+from .GenericSystemHybrid import gensys
+
+# generators whose results can be reused by a GenericSystem with their generation profile, most costly to simulate first
+_reusable_generators = ('pvsamv1', 'windpower', 'pvwattsv8')
+
+
+def _input_key(value):
+    """
+    Hashable form of a nested dictionary of inputs, for comparing the inputs of sweep cases
+    """
+    if isinstance(value, dict):
+        return tuple(sorted((k, _input_key(v)) for k, v in value.items()))
+    if hasattr(value, 'tolist'):
+        value = value.tolist()
+    if isinstance(value, (list, tuple)):
+        return tuple(_input_key(v) for v in value)
+    return value
+
+
+def _financial_outputs(system):
+    """
+    Default results of a sweep case: the Outputs of the financial models
+    """
+    return {name: fin.Outputs.export() for name, fin in system.financials.items()}
+
+
+def _generator_results(gen):
+    """
+    Inputs of a GenericSystem that reproduces the generation and costs of a simulated generator, or None if its
+    generation profile covers the whole analysis period
+    """
+    try:
+        lifetime = gen.value('system_use_lifetime_output')
+    except Exception:
+        lifetime = 0
+    if lifetime:
+        return None
+    inputs = {
+        'spec_mode': 1,
+        'derate': 0,
+        'heat_rate': 0,
+        'conv_eff': 100,
+        'energy_output_array': gen.Outputs.gen,
+        'system_capacity': gen.value('system_capacity'),
+        'user_capacity_factor': gen.Outputs.capacity_factor,
+        'system_use_lifetime_output': 0,
+        'generic_degradation': [0],
+    }
+    inputs.update(gen.HybridCosts.export())
+    return inputs
+
+
+class HybridSweep:
+    """
+    Runs the cases of a hybrid design study, such as a sweep of battery size, interconnection limit or PPA price, on
+    copies of a HybridSystem::
+
+        sweep = HybridSweep(m, workers=4)
+        results = sweep.run([{'battery': {'batt_computed_bank_capacity': kwh}} for kwh in (1000, 2000, 4000)])
+        results = sweep.run([{'hybrid': {'grid_interconnection_limit_kwac': kw}} for kw in (50000, 100000)])
+
+    Each case is a nested dictionary of changes to the inputs of `system`, in the format of `HybridSystem.assign`, so
+    the keys are sub-system names such as "pvwattsv8" and "battery", and "hybrid" for the grid and financial inputs.
+
+    Results are kept by case inputs, and a case that was already run, in this call or an earlier one, is not run again.
+    The remaining cases are ordered so that cases with the same generator inputs follow each other on the same copy.
+    Only the sub-systems whose inputs differ from the previous case on that copy are reset and copied into the hybrid
+    input data, and the copies run on `workers` threads in parallel as with `execute_hybrid_systems`.
+
+    The generation profile and costs of each Pvsamv1, Windpower and Pvwattsv8 generator are kept by the generator's
+    inputs, which are the base inputs with the changes of the case. A later case with the same inputs for that
+    generator, such as a case that only changes the battery, grid or financial inputs, runs with a GenericSystem that
+    supplies the kept profile in place of the generator, so it isn't simulated again. Within a call to `run`, a copy
+    only reuses the profiles kept before the call and the profiles it simulated itself, and the profiles of all copies
+    are kept once the call is done, so whether a case is simulated doesn't depend on the timing of the threads. The Hybrid compute module takes
+    one GenericSystem, so one generator is replaced per case, the most costly to simulate, and none if `system`
+    already has a GenericSystem. For a replaced generator, the `outputs` function gets a HybridSystem with `gensys`
+    in its place.
+
+    :param system: HybridSystem with the base inputs assigned. It is copied and not modified
+    :param int workers: number of copies of `system` that run cases in parallel, default 1
+    :param outputs: function that takes a HybridSystem after execute and returns the results of a case,
+        default is a dictionary of the Outputs of the financial models by name
+    :param bool reuse_generators: replace a generator with its kept profile when its inputs were run before, default True
+    """
+
+    def __init__(self, system: HybridSystem, workers=None, outputs=None, reuse_generators=True):
+        self.workers = workers or 1
+        self.outputs = outputs or _financial_outputs
+        self._base = self._copy_system(system)
+        self.reuse_generators = reuse_generators and 'generic_system' not in self._base.generators
+        # copies of the base system for each worker, by the name of the generator replaced with GenericSystem or None
+        self._systems = []
+        # inputs of each stage of each copy of the base system, as last assigned
+        self._system_keys = []
+        self._results = dict()
+        # GenericSystem inputs that reproduce each generator, by generator name and inputs
+        self._generators = dict()
+
+    @staticmethod
+    def _copy_system(system, replace=None):
+        """
+        Copy of `system`, with the generator named `replace` replaced by GenericSystem
+        """
+        modules = [gensys if name == replace else gen._factory for name, gen in system.generators.items()]
+        copy = HybridSystem(modules, system.financial_module)
+        copy.new()
+        HybridSweep._reset_system(copy, system)
+        return copy
+
+    @staticmethod
+    def _reset_system(system, base, stages=None):
+        """
+        Copy the inputs of `base` into `system`, for all stages or only the stages named in `stages`.
+        Each table is cleared first, so values assigned by an earlier case don't remain
+        """
+        ssc = HybridGenerator._ssc
+        base_generators = base.generators
+        for name, gen in system.generators.items():
+            if (stages is not None and name not in stages) or name not in base_generators:
+                continue
+            gen._discard_hybrid_data()
+            ssc.data_clear(gen._data_ptr)
+            ssc.data_deep_copy(base_generators[name]._data_ptr, gen._data_ptr)
+        if stages is None or 'hybrid' in stages:
+            ssc.data_clear(system.grid.get_data_ptr())
+            ssc.data_deep_copy(base.grid.get_data_ptr(), system.grid.get_data_ptr())
+
+    def _system(self, i, replace):
+        if replace not in self._systems[i]:
+            self._systems[i][replace] = self._copy_system(self._base, replace)
+        return self._systems[i][replace]
+
+    def _reused_generator(self, keys, produced):
+        """
+        Name of the generator to replace for a case and the GenericSystem inputs that reproduce it, or None, None.
+        The profiles are looked up in those kept by earlier calls to `run` and in `produced` by the same copy
+        """
+        if self.reuse_generators:
+            for name in _reusable_generators:
+                key = (name, keys.get(name))
+                inputs = self._generators.get(key, produced.get(key))
+                if inputs is not None:
+                    return name, inputs
+        return None, None
+
+    def _stage_keys(self, case):
+        return {name: _input_key(case.get(name, dict())) for name in list(self._base.generators.keys()) + ['hybrid']}
+
+    def _run_cases(self, i, cases):
+        """
+        Run `cases` in order on the i-th copy, reassigning only the stages whose inputs changed since its previous case.
+        Returns the results of the cases and the generator profiles simulated on this copy, which aren't shared with
+        the other copies until all have finished
+        """
+        results = []
+        produced = dict()
+        for case, keys in cases:
+            replace, inputs = self._reused_generator(keys, produced)
+            system = self._system(i, replace)
+            system_keys = self._system_keys[i].get(replace, dict())
+            changed = [name for name, key in keys.items() if name != replace and system_keys.get(name) != key]
+            self._reset_system(system, self._base, changed)
+            system.assign({name: case[name] for name in changed if name in case})
+            if replace is not None and system_keys.get(replace) != keys[replace]:
+                system.gensys.assign(inputs)
+                system.gensys.AdjustmentFactors.constant = 0
+            self._system_keys[i][replace] = keys
+
+            system.execute()
+            if replace is None and self.reuse_generators:
+                generators = system.generators
+                for name in _reusable_generators:
+                    key = (name, keys.get(name))
+                    if name in generators and key not in self._generators and key not in produced:
+                        produced[key] = _generator_results(generators[name])
+            results.append(self.outputs(system))
+        return results, produced
+
+    def run(self, cases):
+        """
+        Run the cases that haven't been run before and return the results of all cases
+
+        :param cases: list of nested dictionaries of changes to the base inputs, see `HybridSystem.assign`
+        :return: list of the results of each case, by the `outputs` function
+        """
+        cases = list(cases)
+        case_keys = [self._stage_keys(case) for case in cases]
+        keys = [tuple(k.items()) for k in case_keys]
+
+        new_cases = dict()
+        for case, stage_keys, key in zip(cases, case_keys, keys):
+            if key not in self._results and key not in new_cases:
+                new_cases[key] = (case, stage_keys)
+
+        if new_cases:
+            generators = list(self._base.generators.keys())
+            ordered = sorted(new_cases.items(), key=lambda kv: repr([kv[1][1][name] for name in generators]))
+            n = min(self.workers, len(ordered))
+            while len(self._systems) < n:
+                self._systems.append(dict())
+                self._system_keys.append(dict())
+            chunk_size = -(-len(ordered) // n)
+            chunks = [ordered[j:j + chunk_size] for j in range(0, len(ordered), chunk_size)]
+
+            with ThreadPoolExecutor(max_workers=len(chunks)) as executor:
+                futures = [executor.submit(self._run_cases, i, [v for k, v in chunk]) for i, chunk in enumerate(chunks)]
+                outcomes = [future.result() for future in futures]
+            for chunk, (results, produced) in zip(chunks, outcomes):
+                for (key, _), result in zip(chunk, results):
+                    self._results[key] = result
+                for key, inputs in produced.items():
+                    self._generators.setdefault(key, inputs)
+
+        return [self._results[key] for key in keys]
+
+    def clear(self):
+        """
+        Discard the results of all cases run so far, and the kept generator profiles
+        """
+        self._results = dict()
+        self._generators = dict()
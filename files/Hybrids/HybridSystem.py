@@ -1,5 +1,7 @@
 from collections import OrderedDict
-from ctypes import *
+from concurrent.futures import ThreadPoolExecutor
+
+import PySAM.DataTables as tables
 
 from .HybridBase import HybridGenerator
 from .PVWattsHybrid import PVWattsHybrid, pvwatts
@@ -51,8 +53,8 @@ class HybridSystem:
 
         # data container for Hybrid module, ownership will belong to self._hybrid
         self._data_ptr = HybridGenerator._ssc.data_create()
-        # input data container, will be copied into data container. Ownership stays with HybridSystem
-        self._data_input_ptr = HybridGenerator._ssc.data_create()
+        # input data container inside the data container, created on the first execute and reused so it isn't copied
+        self._data_input_ptr = None
         # PySAM model that will perform the Hybrid simulation
         self._hybrid = hybrid.wrap(self._data_ptr)
 
@@ -189,25 +191,57 @@ class HybridSystem:
             raise ValueError(f"{name} is not an output of HybridSystem")
         return self._hybrid.Outputs.output[name]
 
+    @property
+    def generators(self):
+        """
+        Sub-system models by compute module name, such as "pvwattsv8" and "battery", in the order they are simulated
+        """
+        return OrderedDict(self._generators)
+
+    @property
+    def financials(self):
+        """
+        Financial models by compute module name, such as "singleowner"
+        """
+        return OrderedDict(self._financials)
+
+    @property
+    def financial_module(self):
+        """
+        Name of the financial model the system was created with, "singleowner" or "hostdeveloper"
+        """
+        return self._financial_module
+
+    @property
+    def grid(self):
+        """
+        PySAM.Grid model that holds the grid and financial inputs of the hybrid system
+        """
+        return self._grid
+
     def _collect_hybrid_inputs(self):
         """
-        Takes data container from the sub-system models and passes them to the hybrid system input data container, which makes a copy
+        Takes data container from the sub-system models and passes them to the hybrid system input data container, which makes a copy.
+        The input data container is built in place inside the hybrid data container, and sub-system models whose inputs
+        are unchanged since the last execute are already there and aren't copied
         """
+        if self._data_input_ptr is None:
+            self._data_input_ptr = tables.new_table(self._data_ptr, 'input')
+
         for name, gen in self._generators.items():
             gen._collect_inputs(self._data_input_ptr)
 
-        HybridGenerator._ssc.data_set_table(self._data_input_ptr, b'hybrid', self._grid.get_data_ptr())
+        tables.set_table(self._data_input_ptr, 'hybrid', self._grid.get_data_ptr())
+        # the SAM C API has no string data arrays, so the compute module list is set through PySSC
         HybridGenerator._ssc.data_set_data_array(self._data_input_ptr, b'compute_modules', self._cmod_list)
-        HybridGenerator._ssc.data_set_table(self._data_ptr, b'input', self._data_input_ptr)
 
     def _collect_hybrid_outputs(self):
         """
-        Gets sub-system data from the hybrid system model and copies them back to the sub-system classes
+        Copies the grid and financial results back to the grid model, and the sub-system results back to the sub-system classes
         """
-        data_input = HybridGenerator._ssc.data_get_table(self._data_ptr, b'input')
         for name, gen in self._generators.items():
-            gen._collect_outputs(data_input)
-        p_fin_ret = HybridGenerator._ssc.data_get_table(data_input, b'hybrid')
+            gen._collect_outputs(self._data_input_ptr)
+        p_fin_ret = tables.get_table(self._data_input_ptr, 'hybrid')
         data_ptr = self._grid.get_data_ptr()
         HybridGenerator._ssc.data_deep_copy(p_fin_ret, data_ptr)
 
@@ -215,14 +249,45 @@ class HybridSystem:
         """
         Runs a hybrid system simulation
         """
-        HybridGenerator._ssc.data_clear(self._data_input_ptr)
-        HybridGenerator._ssc.data_clear(self._data_ptr)
         self._collect_hybrid_inputs()
-        self._hybrid.execute(verbosity_int)
+        try:
+            self._hybrid.execute(verbosity_int)
+        except Exception:
+            for gen in self._generators.values():
+                gen._discard_hybrid_data()
+            raise
         self._collect_hybrid_outputs()
 
     def export(self):
         """
         Dictionary of hybrid system input and outputs
         """
-        return self._hybrid.export()
\ No newline at end of file
+        return self._hybrid.export()
+
+
+def execute_hybrid_systems(systems, workers=None, verbosity_int=0):
+    """
+    Runs several HybridSystems concurrently on worker threads, such as the cases of a hybrid design study.
+    PySAM.Hybrid releases the GIL while it simulates, so the cases run on separate cores.
+
+    The Hybrid compute module runs the sub-systems of one hybrid system in sequence, and this does not change that.
+    Wall time for a set of cases approaches that of the slowest case rather than the sum of all cases.
+
+    :param systems: list of HybridSystem, each with its own data. The same HybridSystem can't appear twice
+    :param int workers: number of threads, default is the number of systems
+    :param int verbosity_int: verbosity level for each execute
+    :return: list of exceptions raised by each system's execute, None for each system that ran without error
+    """
+    systems = list(systems)
+    if len(set(id(system) for system in systems)) != len(systems):
+        raise ValueError("Each HybridSystem can only be executed once at a time")
+
+    def run(system):
+        try:
+            system.execute(verbosity_int)
+        except Exception as e:
+            return e
+        return None
+
+    with ThreadPoolExecutor(max_workers=workers or max(1, len(systems))) as executor:
+        return list(executor.map(run, systems))
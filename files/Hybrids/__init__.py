@@ -5,4 +5,5 @@ from .WindHybrid import WindHybrid
 from .BatteryHybrid import BatteryHybrid
 from .GenericSystemHybrid import GenericSystemHybrid
 from .FuelCellHybrid import FuelCellHybrid
-from .HybridSystem import HybridSystem
\ No newline at end of file
+from .HybridSystem import HybridSystem
+from .HybridSweep import HybridSweep
\ No newline at end of file
@@ -1,3 +1,5 @@
+import numpy as np
+
 """
 A list of hour of year that ends each month. Given an hourly array,
 hourly_data[max_hrs[0]:max_hrs[1]] would return all of the data from January.
@@ -5,6 +7,14 @@ Multiply indicies by steps per hour to do subhourly data.
 """
 max_hrs = [0, 744, 1416, 2160, 2880, 3624, 4344, 5088, 5832, 6552, 7296, 8016, 8760]
 
+"""
+Same as max_hrs for a leap year, with 29 days in February
+"""
+max_hrs_leap = [0, 744, 1440, 2184, 2904, 3648, 4368, 5112, 5856, 6576, 7320, 8040, 8784]
+
+resample_methods = ('mean', 'sum', 'max', 'instantaneous')
+
+
 def get_monthly_peaks(load_profile, steps_per_hour):
     """
     Get a list of monthly peaks from a grid usage profile
@@ -14,9 +24,97 @@ def get_monthly_peaks(load_profile, steps_per_hour):
         list of one year of load data in floats. Length is 8760 * steps_per_hour
     :param: steps_per_hour:
         integer of steps per hour. 1=hourly data, 4=15 min data, etc
-    :return: list of peak values, length 12
+    :return: list of peak values, length 12. For more than one year of data, the peak of each month across years
+    """
+    peaks = resample_to_monthly(load_profile, steps_per_hour, 'max')
+    return peaks.reshape(-1, 12).max(axis=0).tolist()
+
+
+def resample_timeseries(timeseries, steps_per_hour_in, steps_per_hour_out, method='mean'):
+    """
+    Convert a timeseries between time steps, e.g. 5-minute `gen` to hourly for Utilityrate5 or
+    hourly resource data to 15-minute. The conversion is done on whole arrays without Python loops,
+    and the length may be any number of years, including leap years.
+
+    Aggregating to a longer time step:
+        mean: average of the steps in each interval, for power [kW] or irradiance
+        sum: total of the steps in each interval, for energy [kWh]
+        max: peak of the steps in each interval, for demand
+        instantaneous: first step of each interval, for point values such as temperature
+    Disaggregating to a shorter time step, 'sum' divides each value evenly across the new steps and the
+    other methods repeat each value.
+
+    :param: timeseries:
+        sequence or buffer of data, such as a numpy array or a PySAM output tuple
+    :param: steps_per_hour_in:
+        integer steps per hour of `timeseries`
+    :param: steps_per_hour_out:
+        integer steps per hour of the result. One of the two must divide the other
+    :param: method:
+        'mean', 'sum', 'max', or 'instantaneous'
+    :return: numpy array of length len(timeseries) * steps_per_hour_out / steps_per_hour_in
+    """
+    if method not in resample_methods:
+        raise ValueError(f"method must be one of {resample_methods}")
+    values = np.asarray(timeseries, dtype=float)
+    if steps_per_hour_in == steps_per_hour_out:
+        return values.copy()
+
+    if steps_per_hour_in > steps_per_hour_out:
+        if steps_per_hour_in % steps_per_hour_out:
+            raise ValueError("steps_per_hour_in must be a multiple of steps_per_hour_out")
+        n = steps_per_hour_in // steps_per_hour_out
+        if len(values) % n:
+            raise ValueError(f"Timeseries length {len(values)} is not a whole number of output steps")
+        intervals = values.reshape(-1, n)
+        if method == 'mean':
+            return intervals.mean(axis=1)
+        elif method == 'sum':
+            return intervals.sum(axis=1)
+        elif method == 'max':
+            return intervals.max(axis=1)
+        return intervals[:, 0].copy()
+    else:
+        if steps_per_hour_out % steps_per_hour_in:
+            raise ValueError("steps_per_hour_out must be a multiple of steps_per_hour_in")
+        n = steps_per_hour_out // steps_per_hour_in
+        result = np.repeat(values, n)
+        if method == 'sum':
+            result /= n
+        return result
+
+
+def resample_to_monthly(timeseries, steps_per_hour, method='sum', leap_year=None):
+    """
+    Aggregate a timeseries of one or more years into monthly values, replacing slicing by `max_hrs`
+
+    :param: timeseries:
+        sequence or buffer of one or more years of data
+    :param: steps_per_hour:
+        integer of steps per hour. 1=hourly data, 4=15 min data, etc
+    :param: method:
+        'mean', 'sum', 'max', or 'instantaneous', see `resample_timeseries`
+    :param: leap_year:
+        True if each year contains Feb 29. Default None detects leap years from the length of a single year
+    :return: numpy array of length 12 * number of years
     """
-    peaks = []
-    for i in range(0, 12):
-        peaks.append(max(load_profile[max_hrs[i]:max_hrs[i + 1]]))
-    return peaks
+    if method not in resample_methods:
+        raise ValueError(f"method must be one of {resample_methods}")
+    values = np.asarray(timeseries, dtype=float)
+    if leap_year is None:
+        leap_year = len(values) == 8784 * steps_per_hour
+    month_ends = np.array(max_hrs_leap if leap_year else max_hrs) * int(steps_per_hour)
+
+    year_steps = month_ends[-1]
+    if len(values) % year_steps:
+        raise ValueError(f"Timeseries length {len(values)} is not a whole number of years at {steps_per_hour} steps per hour")
+    starts = (np.arange(len(values) // year_steps)[:, None] * year_steps + month_ends[None, :-1]).ravel()
+
+    if method == 'sum':
+        return np.add.reduceat(values, starts)
+    elif method == 'max':
+        return np.maximum.reduceat(values, starts)
+    elif method == 'mean':
+        lengths = np.tile(np.diff(month_ends), len(starts) // 12)
+        return np.add.reduceat(values, starts) / lengths
+    return values[starts]
@@ -0,0 +1,372 @@
+import hashlib
+import marshal
+import os
+import re
+import tempfile
+from ctypes import c_void_p
+from stat import S_ISREG
+
+from PySAM.PySSC import PySSC
+import PySAM.DataTables as tables
+
+
+def cmod_name(model):
+    """
+    Name of the SSC compute module of a PySAM model, e.g. "generic_system" for PySAM.GenericSystem.GenericSystem
+
+    :param model: PySAM model
+    :return: str
+    """
+    return re.sub(r'(?<!^)(?=[A-Z])', '_', type(model).__name__).lower()
+
+
+def _new_ssc():
+    ssc = PySSC()
+    ssc.pdll.ssc_data_get_table.restype = c_void_p
+    return ssc
+
+
+def _module_vars(ssc, name):
+    """
+    Names of the inputs and results of a compute module, from its variable information
+    """
+    cmod = ssc.module_create(name.encode("ascii"))
+    if not cmod:
+        raise ValueError(f"Compute module {name} not found. Pass the compute module name of the model")
+    reads = set()
+    writes = set()
+    i = 0
+    while True:
+        info = ssc.module_var_info(cmod, i)
+        if not info:
+            break
+        var_name = ssc.info_name(info).decode("ascii")
+        var_type = ssc.info_var_type(info)
+        if var_type in (ssc.INPUT, ssc.INOUT):
+            reads.add(var_name)
+        if var_type in (ssc.OUTPUT, ssc.INOUT):
+            writes.add(var_name)
+        i += 1
+    ssc.module_free(cmod)
+    return reads, writes
+
+
+class _Unreadable:
+    """
+    Value of a data array or matrix, which can't be read without the types of its entries
+    """
+    pass
+
+
+def _get_value(ssc, data, name):
+    """
+    Value of a variable in a data table as a number, str, list, nested list or dict, or None if it is not assigned
+    """
+    data_type = ssc.data_query(data, name.encode("ascii"))
+    if data_type == ssc.INVALID:
+        return None
+    if data_type == ssc.TABLE:
+        table = ssc.data_get_table(data, name.encode("ascii"))
+        values = dict()
+        key = ssc.data_first(table)
+        while key:
+            values[key.decode("ascii")] = _get_value(ssc, table, key.decode("ascii"))
+            key = ssc.data_next(table)
+        return values
+    if data_type > ssc.TABLE:
+        return _Unreadable()
+    return ssc.data_get_variable(data, name)
+
+
+def _set_value(ssc, data, name, value):
+    """
+    Set a variable in a data table to a value from `_get_value`
+    """
+    if value is None:
+        ssc.data_unassign(data, name.encode("ascii"))
+    elif isinstance(value, (list, tuple)) and len(value) == 0:
+        ssc.data_set_array(data, name.encode("ascii"), [])
+    else:
+        ssc.data_set_variable(data, name, value)
+
+
+def _canonical(value):
+    """
+    Form of a value with the entries of dicts sorted, so equal inputs have the same repr
+    """
+    if isinstance(value, dict):
+        return tuple(sorted((k, _canonical(v)) for k, v in value.items()))
+    if isinstance(value, (list, tuple)):
+        return tuple(_canonical(v) for v in value)
+    return value
+
+
+def _file_stamp(value):
+    """
+    Size and modification time of the file named by a str input, or None if it isn't the path of a file
+    """
+    if not isinstance(value, str) or not value:
+        return None
+    try:
+        stat = os.stat(value)
+    except (OSError, ValueError):
+        return None
+    if not S_ISREG(stat.st_mode):
+        return None
+    return stat.st_size, stat.st_mtime_ns
+
+
+class Pipeline:
+    """
+    Runs a chain of PySAM models that share their data, created with `from_existing`, and skips the models whose inputs
+    haven't changed since the last `execute`, along with their results::
+
+        pv_model = Pvwattsv8.default("PVWattsBatteryCommercial")
+        batt_model = Battwatts.from_existing(pv_model, "PVWattsBatteryCommercial")
+        ur_model = Utilityrate5.from_existing(pv_model, "PVWattsBatteryCommercial")
+        fin_model = Cashloan.from_existing(pv_model, "PVWattsBatteryCommercial")
+
+        pipeline = PySAM.PipelineTools.Pipeline([pv_model, batt_model, ur_model, fin_model])
+        pipeline.execute()  # runs all four models
+        ur_model.ElectricityRates.ur_ec_tou_mat = tou_mat
+        pipeline.execute()  # runs Utilityrate5 and Cashloan only
+
+    The inputs of a stage are the INPUT and INOUT variables of its compute module. Inputs that are results of an earlier
+    stage, such as `gen` for Utilityrate5, are tracked through the stage that computes them: when a stage runs, all the
+    stages after it run too. The remaining inputs of each stage are fingerprinted in C when it runs, and the first stage
+    with a different fingerprint on the next `execute` is where the pipeline restarts.
+
+    Inputs that the stage itself or a later stage overwrites, such as `gen` for Battwatts, are saved before the stage
+    runs and restored before it runs again. They are also fingerprinted after each `execute`, so a change made to one
+    directly is detected, and the changed value is used instead of the saved one.
+
+    Inputs that are results of an earlier stage should not be changed directly. Call `invalidate` after doing so.
+
+    :param stages: list of PySAM models in the order they run, all sharing one data table. Each may instead be a tuple
+        of a model and its compute module name, for models whose name is not the compute module name in CamelCase
+    :param cache: optional ResultCache that stages are run through when their inputs changed
+    """
+
+    def __init__(self, stages, cache=None):
+        self.cache = cache
+        self._ssc = _new_ssc()
+        self.models = []
+        self.names = []
+        for stage in stages:
+            if isinstance(stage, tuple):
+                model, name = stage
+            else:
+                model, name = stage, cmod_name(stage)
+            self.models.append(model)
+            self.names.append(name)
+
+        self._data_ptr = self.models[0].get_data_ptr()
+        for model in self.models[1:]:
+            if model.get_data_ptr() != self._data_ptr:
+                raise ValueError("Pipeline models must share their data. Create them with `from_existing`")
+
+        self._reads = []
+        self._writes = []
+        for name in self.names:
+            reads, writes = _module_vars(self._ssc, name)
+            self._reads.append(reads)
+            self._writes.append(writes)
+
+        # for each stage: inputs fingerprinted before it runs, inputs that it or a later stage overwrites, and of
+        # those, the ones that aren't results of an earlier stage, which are fingerprinted after each execute
+        self._inputs = []
+        self._overwritten = []
+        self._tracked = []
+        earlier = set()
+        for i in range(len(self.names)):
+            later = set().union(*self._writes[i:])
+            self._inputs.append(frozenset(self._reads[i] - earlier - later))
+            self._overwritten.append(sorted(self._reads[i] & later))
+            self._tracked.append(sorted((self._reads[i] & later) - earlier))
+            earlier |= self._writes[i]
+
+        self._fingerprints = [None] * len(self.names)
+        self._saved = [None] * len(self.names)
+        self._tracked_fingerprints = [dict() for _ in self.names]
+
+    def _fingerprint(self, names):
+        return tables.fingerprint(self._data_ptr, names)
+
+    def _restore(self, i, skip):
+        for name, value in self._saved[i].items():
+            if name not in skip and not isinstance(value, _Unreadable):
+                _set_value(self._ssc, self._data_ptr, name, value)
+
+    def execute(self, verbosity=0):
+        """
+        Run the stages from the first one whose inputs changed since the last `execute`
+
+        :param int verbosity: verbosity of each model's execute
+        :return: list of the compute module names of the stages that ran
+        """
+        fingerprints = [self._fingerprint(self._inputs[i]) for i in range(len(self.models))]
+        # overwritten inputs changed directly since the last execute
+        edited = [{name for name, fingerprint in self._tracked_fingerprints[i].items()
+                   if self._fingerprint((name,)) != fingerprint} for i in range(len(self.models))]
+        start = 0
+        while start < len(self.models) and fingerprints[start] == self._fingerprints[start] and not edited[start]:
+            start += 1
+
+        # results of the stages that rerun before stage i are current and aren't restored
+        rerun = set()
+        for i in range(start, len(self.models)):
+            if self._saved[i] is not None:
+                self._restore(i, edited[i] | rerun)
+            self._fingerprints[i] = None
+            self._saved[i] = {name: _get_value(self._ssc, self._data_ptr, name) for name in self._overwritten[i]}
+            if self.cache:
+                self.cache.execute(self.models[i], verbosity, self.names[i])
+            else:
+                self.models[i].execute(verbosity)
+            self._fingerprints[i] = fingerprints[i]
+            rerun |= self._writes[i]
+
+        for i in range(len(self.models)):
+            self._tracked_fingerprints[i] = {name: self._fingerprint((name,)) for name in self._tracked[i]}
+        return self.names[start:]
+
+    def invalidate(self, stage=0):
+        """
+        Run all stages from `stage` on the next `execute`
+
+        :param stage: index or compute module name of the first stage to run
+        """
+        if isinstance(stage, str):
+            stage = self.names.index(stage)
+        for i in range(stage, len(self.models)):
+            self._fingerprints[i] = None
+
+
+class ResultCache:
+    """
+    Cache of model results in a directory, shared by processes and runs, such as the cases of nightly jobs that
+    repeat the same site, system and tariff::
+
+        cache = PySAM.PipelineTools.ResultCache("/scratch/pysam_cache")
+        cache.execute(model)  # simulates, or restores the results of an earlier run with the same inputs
+
+    A result is keyed by a hash of the compute module name, the SSC version and the values of all the compute module's
+    INPUT and INOUT variables in the model's data, including arrays, matrices and tables. On a hit, the compute
+    module's results are assigned into the model's data and the model isn't simulated. String inputs that name a file,
+    such as `solar_resource_file` and `wind_resource_filename`, are keyed by the file's size and modification time
+    as well as its path, so a weather file that is replaced in place gets new results. Files read by a path within
+    a table input are keyed by path only.
+
+    Results are stored in marshal files, one per key, which are written to a temporary file and then renamed, so
+    concurrent writers never leave a partial file. Models with inputs that are data arrays or data matrices are
+    simulated and not cached.
+
+    :param str directory: path of the cache directory, created if it doesn't exist
+    """
+
+    def __init__(self, directory):
+        self.directory = directory
+        os.makedirs(directory, exist_ok=True)
+        self._ssc = _new_ssc()
+        self._version = self._ssc.version()
+        self._module_vars = dict()
+        self.hits = 0
+        self.misses = 0
+
+    def _vars(self, name):
+        if name not in self._module_vars:
+            reads, writes = _module_vars(self._ssc, name)
+            self._module_vars[name] = (sorted(reads), sorted(writes))
+        return self._module_vars[name]
+
+    def key(self, model, name=None):
+        """
+        Hash of the compute module, SSC version and inputs of a model, or None if its inputs can't all be read
+
+        :param model: PySAM model
+        :param str name: compute module name, default from `cmod_name`
+        :return: str
+        """
+        name = name or cmod_name(model)
+        data = model.get_data_ptr()
+        h = hashlib.sha256()
+        h.update(f"{name}\n{self._version}\n".encode("ascii"))
+        for var in self._vars(name)[0]:
+            value = _get_value(self._ssc, data, var)
+            if isinstance(value, _Unreadable):
+                return None
+            h.update(var.encode("ascii"))
+            h.update(repr(_canonical(value)).encode("ascii"))
+            stamp = _file_stamp(value)
+            if stamp is not None:
+                h.update(repr(stamp).encode("ascii"))
+        return h.hexdigest()
+
+    def _path(self, key):
+        return os.path.join(self.directory, key[:2], key + ".df")
+
+    def execute(self, model, verbosity=0, name=None):
+        """
+        Restore the results of a model from the cache if its inputs were run before, otherwise execute it and store the results
+
+        :param model: PySAM model
+        :param int verbosity: verbosity of the model's execute
+        :param str name: compute module name, default from `cmod_name`
+        :return: True if the results were restored from the cache
+        """
+        name = name or cmod_name(model)
+        key = self.key(model, name)
+        if key is None:
+            model.execute(verbosity)
+            return False
+
+        path = self._path(key)
+        try:
+            with open(path, "rb") as f:
+                results = marshal.load(f)
+        except (OSError, EOFError, ValueError, TypeError):
+            results = None
+        if results is not None:
+            data = model.get_data_ptr()
+            for var, value in results.items():
+                _set_value(self._ssc, data, var, value)
+            self.hits += 1
+            return True
+
+        model.execute(verbosity)
+        self.misses += 1
+
+        data = model.get_data_ptr()
+        results = dict()
+        for var in self._vars(name)[1]:
+            value = _get_value(self._ssc, data, var)
+            if isinstance(value, _Unreadable):
+                return False
+            if value is not None:
+                results[var] = value
+
+        os.makedirs(os.path.dirname(path), exist_ok=True)
+        fd, tmp_path = tempfile.mkstemp(dir=os.path.dirname(path), suffix=".tmp")
+        try:
+            with os.fdopen(fd, "wb") as f:
+                marshal.dump(results, f)
+            os.replace(tmp_path, path)
+        except BaseException:
+            os.remove(tmp_path)
+            raise
+        return False
+
+    def clear(self):
+        """
+        Remove all results from the cache directory
+        """
+        for sub_dir in os.listdir(self.directory):
+            sub_path = os.path.join(self.directory, sub_dir)
+            if not os.path.isdir(sub_path):
+                continue
+            for filename in os.listdir(sub_path):
+                if filename.endswith(".df"):
+                    try:
+                        os.remove(os.path.join(sub_path, filename))
+                    except FileNotFoundError:
+                        pass
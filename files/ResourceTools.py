@@ -159,10 +159,8 @@ def URDBv7_to_ElectricityRates(urdb_response):
 
     def try_get_schedule(urdb_name, data_name):
         if urdb_name in urdb_response.keys():
-            urdb_data[data_name] = urdb_response[urdb_name]
-            for i in range(12):
-                for j in range(24):
-                    urdb_data[data_name][i][j] += 1
+            # URDB periods are 0-indexed, SAM periods are 1-indexed. Copy so urdb_response is not modified
+            urdb_data[data_name] = [[period + 1 for period in month] for month in urdb_response[urdb_name]]
 
     def try_get_rate_structure(urdb_name, data_name):
         mat = []
@@ -612,3 +610,363 @@ class FetchResourceFiles():
         self.resource_file_paths = results
         self.resource_file_paths_dict = dict(zip(points, results))
         return self
+
+
+def _bounded_process_map(fn, jobs, workers):
+    """
+    Runs `fn` on each job in worker processes, yielding (job, result, exception) as jobs finish.
+    At most 2 * workers jobs are queued at a time so `jobs` can be a generator over any number of files.
+    """
+    with cf.ProcessPoolExecutor(max_workers=workers) as executor:
+        pending = dict()
+        jobs = iter(jobs)
+        exhausted = False
+        while True:
+            while not exhausted and len(pending) < 2 * workers:
+                try:
+                    job = next(jobs)
+                except StopIteration:
+                    exhausted = True
+                    break
+                pending[executor.submit(fn, job)] = job
+            if not pending:
+                return
+            done, _ = cf.wait(pending, return_when=cf.FIRST_COMPLETED)
+            for future in done:
+                job = pending.pop(future)
+                exc = future.exception()
+                yield job, None if exc else future.result(), exc
+
+
+def _wfcsvconv_worker(job):
+    """
+    Converts a single weather file with PySAM.Wfcsvconv. Runs inside a worker process of
+    `convert_weather_files` so only one file is held in memory per worker at a time.
+    """
+    import PySAM.Wfcsvconv as wfcsvconv
+
+    input_file, output_file, packed = job
+
+    model = wfcsvconv.new()
+    model.WeatherFileConverter.input_file = input_file
+    model.WeatherFileConverter.output_file = output_file
+    model.execute(0)
+
+    packed_file = None
+    if packed:
+        packed_file = os.path.splitext(output_file)[0] + ".npz"
+        weather = SAM_CSV_to_solar_data(output_file)
+        columns = {k: np.asarray(v, dtype=np.float32) for k, v in weather.items() if isinstance(v, list)}
+        header = np.array([weather['lat'], weather['lon'], weather['tz'], weather['elev']])
+        np.savez(packed_file, header=header, **columns)
+
+    return input_file, output_file, packed_file, os.path.getsize(input_file)
+
+
+def convert_weather_files(input_files, output_folder, workers=1, packed=False, verbose=True):
+    """
+    Converts many weather files to SAM CSV format with PySAM.Wfcsvconv, writing each converted file
+    directly to `output_folder` under the input file's name.
+
+    Conversions run in separate worker processes. At most `2 * workers` files are queued at any time
+    so `input_files` may be a generator over an arbitrarily large archive without holding the whole
+    file list or any converted data in memory.
+
+    :param iterable input_files: Paths to weather files in any format read by Wfcsvconv.
+    :param str output_folder: Directory to write converted files, created if it does not exist.
+    :param int workers: Number of worker processes. Default = 1.
+    :param bool packed: Also write a packed columnar `.npz` file next to each converted file, with float32
+        columns named as in `SAM_CSV_to_solar_data` and a `header` array of [lat, lon, tz, elev].
+        Default = False.
+    :param bool verbose: Print throughput when finished. Default = True.
+
+    :return: Dictionary {files (dict), failed (dict), n_files (int), n_bytes (int), seconds (float), files_per_second (float), mb_per_second (float)}
+
+        files: dict
+            Converted file path keyed by input file path, or (csv path, npz path) if `packed`.
+        failed: dict
+            Error message keyed by input file path for files that could not be converted, including files with the
+            same name as an earlier input file, whose output would overwrite it.
+    """
+    import time
+
+    if not os.path.exists(output_folder):
+        os.makedirs(output_folder)
+
+    files = dict()
+    failed = dict()
+    # input file keyed by output file, to detect inputs with the same name in different folders
+    outputs = dict()
+    n_bytes = 0
+    start = time.perf_counter()
+
+    def make_jobs():
+        for input_file in input_files:
+            input_file = str(input_file)
+            try:
+                output_file = os.path.join(output_folder, os.path.splitext(os.path.basename(input_file))[0] + ".csv")
+                output_key = os.path.normcase(os.path.abspath(output_file))
+                if output_key == os.path.normcase(os.path.abspath(input_file)):
+                    raise ValueError(f"Output file would overwrite input file {input_file}. Choose a different output_folder.")
+                if output_key in outputs:
+                    raise ValueError(f"Output file {output_file} is already written for {outputs[output_key]}, which has the same name.")
+            except Exception as e:
+                failed[input_file] = str(e)
+                continue
+            outputs[output_key] = input_file
+            yield input_file, output_file, packed
+
+    for job, result, exc in _bounded_process_map(_wfcsvconv_worker, make_jobs(), workers):
+        if exc:
+            failed[job[0]] = str(exc)
+            continue
+        _, output_file, packed_file, size = result
+        files[job[0]] = (output_file, packed_file) if packed else output_file
+        n_bytes += size
+
+    seconds = time.perf_counter() - start
+    stats = {
+        'files': files,
+        'failed': failed,
+        'n_files': len(files),
+        'n_bytes': n_bytes,
+        'seconds': seconds,
+        'files_per_second': len(files) / seconds if seconds > 0 else 0,
+        'mb_per_second': n_bytes / 1e6 / seconds if seconds > 0 else 0
+    }
+    if verbose:
+        print('Converted {} files ({:.1f} MB) in {:.1f} s: {:.2f} files/s, {:.2f} MB/s. {} failed.'.format(
+            stats['n_files'], n_bytes / 1e6, seconds, stats['files_per_second'], stats['mb_per_second'], len(failed)))
+    return stats
+
+
+def _marine_reader_worker(job):
+    """
+    Reads a single wave or tidal resource file. Runs inside a worker process of `read_marine_resource_files`.
+    """
+    tech, filename, model_choice = job
+
+    if tech == 'wave':
+        import PySAM.WaveFileReader as reader
+        model = reader.new()
+        model.WeatherReader.wave_resource_model_choice = model_choice
+        if model_choice == 0:
+            model.WeatherReader.wave_resource_filename = filename
+        else:
+            model.WeatherReader.wave_resource_filename_ts = filename
+    else:
+        import PySAM.TidalFileReader as reader
+        model = reader.new()
+        model.WeatherReader.tidal_resource_model_choice = model_choice
+        model.WeatherReader.tidal_resource_filename = filename
+    model.execute(0)
+
+    return {k: np.asarray(v) if isinstance(v, tuple) else v for k, v in model.Outputs.export().items()}
+
+
+class MarineResourceData():
+    """
+    Wave or tidal resource data read from many files by `read_marine_resource_files`.
+
+    Array outputs of WaveFileReader or TidalFileReader are stored by column in `columns`, with the first axis
+    indexing the file. Columns whose shape is the same for every file are stacked into a single numpy array,
+    otherwise the column is a list of numpy arrays. Scalar and string outputs such as `lat`, `lon` and `name`
+    are stored per file in `metadata`.
+
+    :param str tech: 'wave' or 'tidal'.
+    :param int model_choice: 0 for joint probability distribution files, 1 for time series files.
+    :param list filenames: Resource files in the order they are stored.
+    """
+    mhk_inputs_by_tech = {
+        'wave': {0: ('wave_resource_matrix',), 1: ('significant_wave_height', 'energy_period', 'year', 'month', 'day', 'hour', 'minute')},
+        'tidal': {1: ('tidal_velocity',)}
+    }
+
+    def __init__(self, tech, model_choice, filenames, outputs):
+        self.tech = tech
+        self.model_choice = model_choice
+        self.filenames = list(filenames)
+        self.columns = dict()
+        self.metadata = []
+
+        for out in outputs:
+            self.metadata.append({k: v for k, v in out.items() if not isinstance(v, np.ndarray)})
+        names = set().union(*[out.keys() for out in outputs]) if outputs else set()
+        for name in names:
+            values = [out.get(name) for out in outputs]
+            if not all(isinstance(v, np.ndarray) for v in values):
+                continue
+            if all(v.shape == values[0].shape for v in values):
+                self.columns[name] = np.stack(values)
+            else:
+                self.columns[name] = values
+
+    def __len__(self):
+        return len(self.filenames)
+
+    def mhk_inputs(self, i):
+        """
+        Inputs for PySAM.MhkWave.MHKWave or PySAM.MhkTidal.MHKTidal from the `i`-th file
+
+        :param int i: Index of file in `filenames`
+        :return: dictionary of resource inputs
+        """
+        inputs = {self.tech + '_resource_model_choice': self.model_choice}
+        for name in self.mhk_inputs_by_tech[self.tech][self.model_choice]:
+            if name in self.columns:
+                inputs[name] = self.columns[name][i].tolist()
+        return inputs
+
+    def assign(self, model, i):
+        """
+        Assign the `i`-th file's resource to an MhkWave or MhkTidal model
+
+        :param model: PySAM.MhkWave.MhkWave or PySAM.MhkTidal.MhkTidal
+        :param int i: Index of file in `filenames`
+        """
+        if self.tech == 'wave':
+            model.MHKWave.assign(self.mhk_inputs(i))
+        else:
+            model.MHKTidal.assign(self.mhk_inputs(i))
+
+
+def read_marine_resource_files(filenames, tech='wave', model_choice=0, workers=1):
+    """
+    Reads many wave or tidal resource files with PySAM.WaveFileReader or PySAM.TidalFileReader in parallel
+    worker processes into a single columnar MarineResourceData
+
+        i.e.
+            resource = PySAM.ResourceTools.read_marine_resource_files(files, 'wave', 0, workers=8)
+            model = PySAM.MhkWave.default("MEwaveLCOECalculator")
+            for i in range(len(resource)):
+                resource.assign(model, i)
+                model.execute()
+
+    :param iterable filenames: Wave or tidal resource files
+    :param str tech: 'wave' or 'tidal'. Default = 'wave'.
+    :param int model_choice: 0 for joint probability distribution files, 1 for time series files. Default = 0.
+        TidalFileReader has no output for MhkTidal's joint probability distribution input `tidal_resource`, so
+        tidal files must be time series.
+    :param int workers: Number of worker processes. Default = 1.
+
+    :return: MarineResourceData with the outputs of every file
+    """
+    tech = tech.lower()
+    if tech not in ('wave', 'tidal'):
+        raise NotImplementedError(f"read_marine_resource_files not enabled for technology {tech}")
+    if model_choice not in (0, 1):
+        raise ValueError("model_choice must be 0 for joint probability distribution or 1 for time series")
+    if tech == 'tidal' and model_choice == 0:
+        raise ValueError("TidalFileReader does not read joint probability distributions for MhkTidal's tidal_resource. "
+                         "Use model_choice 1 for time series files, or assign tidal_resource directly")
+
+    filenames = [str(f) for f in filenames]
+    for filename in filenames:
+        if not os.path.isfile(filename):
+            raise FileNotFoundError(filename + " does not exist.")
+    jobs = [(tech, filename, model_choice) for filename in filenames]
+
+    if workers > 1:
+        with cf.ProcessPoolExecutor(max_workers=workers) as executor:
+            outputs = list(executor.map(_marine_reader_worker, jobs))
+    else:
+        outputs = [_marine_reader_worker(job) for job in jobs]
+
+    return MarineResourceData(tech, model_choice, filenames, outputs)
+
+
+def _file_digest(filename, chunk_size=1 << 20):
+    import hashlib
+
+    digest = hashlib.sha1()
+    with open(filename, 'rb') as f:
+        for chunk in iter(lambda: f.read(chunk_size), b''):
+            digest.update(chunk)
+    return digest.hexdigest()
+
+
+def _wfcheck_worker(job):
+    """
+    Hashes and checks a single weather file with PySAM.Wfcheck. Runs inside a worker process of
+    `validate_weather_files`. If the hash matches `cached`, the cached result is returned without checking.
+    """
+    import PySAM.Wfcheck as wfcheck
+
+    filename, cached = job
+    digest = _file_digest(filename)
+    if cached and cached['hash'] == digest:
+        return cached['valid'], cached['message'], digest
+
+    model = wfcheck.new()
+    model.WeatherFileChecker.input_file = filename
+    try:
+        model.execute(0)
+    except Exception as e:
+        return False, str(e), digest
+    return True, "", digest
+
+
+def validate_weather_files(filenames, workers=1, cache_file=None, verbose=True):
+    """
+    Checks many weather files with PySAM.Wfcheck in parallel worker processes, as a pre-flight before batch jobs.
+    Files are read in chunks when hashed and at most 2 * workers files are queued, so memory use does not grow
+    with the number of files.
+
+    If `cache_file` is provided, pass/fail results are stored there with each file's size, modification time and
+    SHA-1 content hash. Files whose size and modification time match the cache are not read again, and files whose
+    content hash matches are not checked again.
+
+    :param iterable filenames: Weather files in any format read by Wfcheck.
+    :param int workers: Number of worker processes. Default = 1.
+    :param str cache_file: JSON file of cached results, created if it does not exist. Default = None for no cache.
+    :param bool verbose: Print number of invalid files. Default = True.
+
+    :return: Dictionary of (valid (bool), message (str)) keyed by file path. Files that are missing or can't be
+        read are invalid, with the error as the message
+    """
+    cache = dict()
+    if cache_file and os.path.isfile(cache_file):
+        with open(cache_file) as f:
+            cache = json.load(f)
+
+    results = dict()
+
+    def make_jobs():
+        for filename in filenames:
+            filename = os.path.abspath(str(filename))
+            try:
+                stat = os.stat(filename)
+            except OSError as e:
+                results[filename] = (False, str(e))
+                continue
+            cached = cache.get(filename)
+            if cached and cached['size'] == stat.st_size and cached['mtime'] == stat.st_mtime:
+                results[filename] = (cached['valid'], cached['message'])
+                continue
+            yield filename, cached
+
+    for job, result, exc in _bounded_process_map(_wfcheck_worker, make_jobs(), workers):
+        filename = job[0]
+        if exc:
+            results[filename] = (False, str(exc))
+            continue
+        valid, message, digest = result
+        results[filename] = (valid, message)
+        try:
+            stat = os.stat(filename)
+        except OSError:
+            continue
+        cache[filename] = {'size': stat.st_size, 'mtime': stat.st_mtime, 'hash': digest,
+                           'valid': valid, 'message': message}
+
+    if cache_file:
+        cache_dir = os.path.dirname(os.path.abspath(cache_file))
+        tmp_file = os.path.join(cache_dir, ".{}.{}.tmp".format(os.path.basename(cache_file), os.getpid()))
+        with open(tmp_file, 'w') as f:
+            json.dump(cache, f)
+        os.replace(tmp_file, cache_file)
+
+    if verbose:
+        n_invalid = sum(1 for valid, _ in results.values() if not valid)
+        print('Checked {} weather files: {} invalid.'.format(len(results), n_invalid))
+    return results
@@ -1,3 +1,14 @@
+import concurrent.futures as cf
+import hashlib
+import json
+import marshal
+import mmap
+import os
+import tempfile
+
+import numpy as np
+
+
 def URDBv8_to_ElectricityRates(urdb_response):
     """
     Formats response from Utility Rate Database API version 8 for use in PySAM
@@ -19,10 +30,8 @@ def URDBv8_to_ElectricityRates(urdb_response):
 
     def try_get_schedule(urdb_name, data_name):
         if urdb_name in urdb_response.keys():
-            urdb_data[data_name] = urdb_response[urdb_name]
-            for i in range(12):
-                for j in range(24):
-                    urdb_data[data_name][i][j] += 1
+            # URDB periods are 0-indexed, SAM periods are 1-indexed. Copy so urdb_response is not modified
+            urdb_data[data_name] = [[period + 1 for period in month] for month in urdb_response[urdb_name]]
 
     def try_get_rate_structure(urdb_name, data_name):
         mat = []
@@ -199,4 +208,340 @@ def URDBv8_to_ElectricityRates(urdb_response):
     else:
         urdb_data['ur_enable_billing_demand'] = False
 
-    return urdb_data
\ No newline at end of file
+    return urdb_data
+
+
+class ElectricityRatesCache:
+    """
+    On-disk cache of ElectricityRates dictionaries compiled from URDB responses by URDBv8_to_ElectricityRates,
+    keyed by the URDB rate `label`. Compiled rates are stored in marshal format, the same as PySAM defaults,
+    so reloading a tariff is a single memory-mapped read without re-processing the URDB schedules and tiers.
+        i.e.
+            cache = PySAM.UtilityRateTools.ElectricityRatesCache("rate_cache")
+            model = PySAM.Utilityrate5.new()
+            model.ElectricityRates.assign(cache.compile(urdb_response))
+
+    Entries store a hash of the URDB response they were compiled from and are recompiled when a response with
+    the same label differs. Writes go to a temporary file that is renamed into place, so several processes can
+    share a cache directory.
+
+    :param str cache_dir: Directory of cache files, created if it does not exist.
+    """
+
+    def __init__(self, cache_dir):
+        self.cache_dir = str(cache_dir)
+        if not os.path.exists(self.cache_dir):
+            os.makedirs(self.cache_dir)
+        self._entries = dict()
+
+    def _path(self, label):
+        return os.path.join(self.cache_dir, hashlib.sha1(str(label).encode("utf-8")).hexdigest() + ".rates")
+
+    @staticmethod
+    def _digest(urdb_response):
+        return hashlib.sha1(json.dumps(urdb_response, sort_keys=True, default=str).encode("utf-8")).hexdigest()
+
+    def _load(self, label):
+        if label in self._entries:
+            return self._entries[label]
+        try:
+            with open(self._path(label), "rb") as f:
+                with mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ) as m:
+                    entry = marshal.loads(m)
+        except (OSError, ValueError, EOFError, TypeError):
+            return None
+        self._entries[label] = entry
+        return entry
+
+    def get(self, label):
+        """
+        Get compiled rates by URDB label without checking them against a URDB response
+
+        :param str label: URDB rate label
+        :return: dictionary for PySAM.UtilityRate5.UtilityRate5.ElectricityRates, or None if not cached
+        """
+        entry = self._load(label)
+        return entry['rates'] if entry else None
+
+    def put(self, label, rates, digest=""):
+        """
+        Store compiled rates under a URDB label
+
+        :param str label: URDB rate label
+        :param dict rates: dictionary for PySAM.UtilityRate5.UtilityRate5.ElectricityRates
+        :param str digest: hash of the URDB response the rates were compiled from
+        """
+        entry = {'label': label, 'digest': digest, 'rates': rates}
+        fd, tmp_path = tempfile.mkstemp(dir=self.cache_dir, suffix=".tmp")
+        try:
+            with os.fdopen(fd, "wb") as f:
+                marshal.dump(entry, f)
+            os.replace(tmp_path, self._path(label))
+        except BaseException:
+            if os.path.exists(tmp_path):
+                os.remove(tmp_path)
+            raise
+        self._entries[label] = entry
+
+    def compile(self, urdb_response):
+        """
+        Get the compiled rates for a URDB response from the cache, running URDBv8_to_ElectricityRates
+        only if the rate is not cached or its response has changed. The returned dictionary is shared
+        with the cache and should not be modified.
+
+        :param: urdb_response:
+            dictionary with response fields following
+            https://openei.org/services/doc/rest/util_rates/?version=8
+        :return: dictionary for PySAM.UtilityRate5.UtilityRate5.ElectricityRates
+        """
+        if 'label' not in urdb_response.keys():
+            raise ValueError("ElectricityRatesCache error: URDB response requires a 'label'")
+        label = urdb_response['label']
+        digest = self._digest(urdb_response)
+        entry = self._load(label)
+        if entry and entry['digest'] == digest:
+            return entry['rates']
+        rates = URDBv8_to_ElectricityRates(urdb_response)
+        self.put(label, rates, digest)
+        return rates
+
+
+"""
+Utilityrate5 inputs outside of ElectricityRates used by the bill calculation helpers for first-year bills.
+Override them with the `inputs` argument of those functions.
+"""
+bill_defaults = {
+    'Lifetime': {'analysis_period': 1, 'inflation_rate': 0, 'system_use_lifetime_output': 0},
+    'ElectricityRates': {'rate_escalation': [0]},
+    'SystemOutput': {'degradation': [0]},
+    'Load': {'load_escalation': [0]}
+}
+
+_bill_model = None
+
+
+def _new_bill_model(rates, inputs):
+    import PySAM.Utilityrate5 as utilityrate
+
+    model = utilityrate.new()
+    model.assign(bill_defaults)
+    if inputs:
+        model.assign(inputs)
+    model.ElectricityRates.assign(rates)
+    return model
+
+
+def _bill_worker_init(rates, inputs):
+    """
+    Assigns the tariff once per worker process of `calculate_portfolio_bills`
+    """
+    global _bill_model
+    _bill_model = _new_bill_model(rates, inputs)
+
+
+def _bill_rows(model, load, gen):
+    """
+    Runs the model on each row of `load` and `gen`, returning first-year monthly bills with and without the system
+    """
+    monthly_w_sys = np.empty((len(load), 12))
+    monthly_wo_sys = np.empty((len(load), 12))
+    for i in range(len(load)):
+        model.Load.load = load[i]
+        model.SystemOutput.gen = gen[i]
+        model.execute(0)
+        monthly_w_sys[i] = model.Outputs.year1_monthly_utility_bill_w_sys
+        monthly_wo_sys[i] = model.Outputs.year1_monthly_utility_bill_wo_sys
+    return monthly_w_sys, monthly_wo_sys
+
+
+def _bill_worker(job):
+    start, load, gen = job
+    return (start,) + _bill_rows(_bill_model, load, gen)
+
+
+def calculate_portfolio_bills(rates, load, gen=None, inputs=None, workers=1, chunk_size=100):
+    """
+    Calculates first-year bills for many customers on one tariff with PySAM.Utilityrate5
+        i.e.
+            rates = PySAM.UtilityRateTools.URDBv8_to_ElectricityRates(urdb_response)
+            bills = PySAM.UtilityRateTools.calculate_portfolio_bills(rates, ami_loads, workers=8)
+
+    The tariff is assigned once per worker process and each worker bills chunks of `chunk_size` customers,
+    so only the load and generation profiles are sent per customer. Utilityrate5 still processes the tariff
+    schedules on each execute.
+
+    :param dict rates: dictionary for PySAM.UtilityRate5.UtilityRate5.ElectricityRates
+    :param load: matrix of customer load profiles [kW], customers x timesteps, such as a 2-D numpy array
+    :param gen: optional matrix of customer generation profiles [kW] of the same shape as `load`. Default is no generation
+    :param dict inputs: optional nested dictionary of other Utilityrate5 inputs, overriding `bill_defaults`
+    :param int workers: Number of worker processes. Default = 1, which runs in this process
+    :param int chunk_size: Number of customers per job. Default = 100
+
+    :return: Dictionary {annual_bill_w_sys, monthly_bill_w_sys, annual_bill_wo_sys, monthly_bill_wo_sys}
+        of numpy arrays [$] with one row per customer. Monthly arrays have 12 columns.
+    """
+    load = np.asarray(load, dtype=float)
+    if load.ndim != 2:
+        raise ValueError("load must be a matrix of customers x timesteps")
+    gen = np.zeros_like(load) if gen is None else np.asarray(gen, dtype=float)
+    if gen.shape != load.shape:
+        raise ValueError(f"gen shape {gen.shape} does not match load shape {load.shape}")
+
+    n = len(load)
+    monthly_w_sys = np.empty((n, 12))
+    monthly_wo_sys = np.empty((n, 12))
+    if workers == 1:
+        monthly_w_sys[:], monthly_wo_sys[:] = _bill_rows(_new_bill_model(rates, inputs), load, gen)
+    else:
+        jobs = [(start, load[start:start + chunk_size], gen[start:start + chunk_size]) for start in range(0, n, chunk_size)]
+        with cf.ProcessPoolExecutor(max_workers=workers, initializer=_bill_worker_init, initargs=(rates, inputs)) as executor:
+            for start, chunk_w_sys, chunk_wo_sys in executor.map(_bill_worker, jobs):
+                monthly_w_sys[start:start + len(chunk_w_sys)] = chunk_w_sys
+                monthly_wo_sys[start:start + len(chunk_wo_sys)] = chunk_wo_sys
+
+    return {
+        'annual_bill_w_sys': monthly_w_sys.sum(axis=1),
+        'monthly_bill_w_sys': monthly_w_sys,
+        'annual_bill_wo_sys': monthly_wo_sys.sum(axis=1),
+        'monthly_bill_wo_sys': monthly_wo_sys
+    }
+
+
+def profile_digest(load, gen=None):
+    """
+    Hash of a customer's load and generation profiles, for keying bill results across tariff comparisons
+
+    :param load: load profile [kW]
+    :param gen: optional generation profile [kW]
+    :return: str
+    """
+    h = hashlib.sha1(np.ascontiguousarray(load, dtype=float).tobytes())
+    if gen is not None:
+        h.update(b"gen")
+        h.update(np.ascontiguousarray(gen, dtype=float).tobytes())
+    return h.hexdigest()
+
+
+def _update_digest(h, value):
+    """
+    Updates the hash `h` with a nested dictionary of inputs, hashing numeric sequences and arrays by their bytes
+    so that values numpy abbreviates when printed don't collide
+    """
+    if isinstance(value, dict):
+        h.update(b"{")
+        for k in sorted(value, key=str):
+            h.update(str(k).encode("utf-8") + b":")
+            _update_digest(h, value[k])
+        h.update(b"}")
+    elif isinstance(value, str) or value is None:
+        h.update(b"s" + repr(value).encode("utf-8"))
+    else:
+        try:
+            arr = np.asarray(value, dtype=float)
+        except (TypeError, ValueError):
+            arr = None
+        if arr is not None:
+            h.update(b"a" + repr(arr.shape).encode("ascii"))
+            h.update(np.ascontiguousarray(arr).tobytes())
+        elif isinstance(value, (list, tuple)):
+            h.update(b"[")
+            for v in value:
+                _update_digest(h, v)
+            h.update(b"]")
+        else:
+            h.update(b"r" + repr(value).encode("utf-8"))
+
+
+def _inputs_digest(value):
+    """
+    Hash of a nested dictionary of inputs or rates, for keying bill results
+    """
+    h = hashlib.sha1()
+    _update_digest(h, value)
+    return h.hexdigest()
+
+
+_tariff_model = None
+_tariff_base_rates = None
+
+
+def _new_customer_model(load, gen, inputs):
+    """
+    Utilityrate5 model with a customer's profiles assigned and no tariff, plus the ElectricityRates inputs that are not part of a tariff
+    """
+    model = _new_bill_model(dict(), inputs)
+    model.Load.load = load
+    model.SystemOutput.gen = gen
+    base_rates = dict(bill_defaults['ElectricityRates'])
+    if inputs:
+        base_rates.update(inputs.get('ElectricityRates', dict()))
+    return model, base_rates
+
+
+def _bill_tariff(model, base_rates, rates):
+    model.ElectricityRates.replace(dict(base_rates, **rates))
+    model.execute(0)
+    return model.Outputs.year1_monthly_utility_bill_w_sys, model.Outputs.year1_monthly_utility_bill_wo_sys
+
+
+def _tariff_worker_init(load, gen, inputs):
+    """
+    Assigns the customer's profiles once per worker process of `compare_tariffs`
+    """
+    global _tariff_model, _tariff_base_rates
+    _tariff_model, _tariff_base_rates = _new_customer_model(load, gen, inputs)
+
+
+def _tariff_worker(rates):
+    return _bill_tariff(_tariff_model, _tariff_base_rates, rates)
+
+
+def compare_tariffs(rates_list, load, gen=None, inputs=None, workers=1, cache=None):
+    """
+    Calculates first-year bills for one customer on many candidate tariffs with PySAM.Utilityrate5
+        i.e.
+            candidates = [cache.compile(response) for response in urdb_responses]
+            bills = PySAM.UtilityRateTools.compare_tariffs(candidates, load, gen, workers=4)
+
+    The load and generation profiles are assigned once per model and only ElectricityRates is replaced for
+    each tariff. Bills are stored in `cache`, if provided, keyed by the profiles and tariff, so tariffs already
+    evaluated for the same customer are not run again.
+
+    Utilityrate5 does not expose its per-period energy and peak aggregations, so each new tariff still runs the full
+    bill calculation inside ssc.
+
+    :param list rates_list: dictionaries for PySAM.UtilityRate5.UtilityRate5.ElectricityRates, one per tariff
+    :param load: load profile [kW]
+    :param gen: optional generation profile [kW]. Default is no generation
+    :param dict inputs: optional nested dictionary of other Utilityrate5 inputs, overriding `bill_defaults`
+    :param int workers: Number of worker processes. Default = 1, which runs in this process
+    :param dict cache: optional dictionary of previous results, updated with new results
+
+    :return: Dictionary {annual_bill_w_sys, monthly_bill_w_sys, annual_bill_wo_sys, monthly_bill_wo_sys}
+        of numpy arrays [$] with one row per tariff. Monthly arrays have 12 columns.
+    """
+    load = np.asarray(load, dtype=float)
+    gen = np.zeros_like(load) if gen is None else np.asarray(gen, dtype=float)
+    profile_key = profile_digest(load, gen) + _inputs_digest(inputs or dict())
+
+    keys = [profile_key + _inputs_digest(rates) for rates in rates_list]
+    cache = cache if cache is not None else dict()
+    todo = [i for i, key in enumerate(keys) if key not in cache]
+    if todo:
+        if workers == 1:
+            model, base_rates = _new_customer_model(load, gen, inputs)
+            results = [_bill_tariff(model, base_rates, rates_list[i]) for i in todo]
+        else:
+            with cf.ProcessPoolExecutor(max_workers=workers, initializer=_tariff_worker_init, initargs=(load, gen, inputs)) as executor:
+                results = list(executor.map(_tariff_worker, [rates_list[i] for i in todo]))
+        for i, result in zip(todo, results):
+            cache[keys[i]] = result
+
+    monthly_w_sys = np.array([cache[key][0] for key in keys], dtype=float).reshape(len(keys), 12)
+    monthly_wo_sys = np.array([cache[key][1] for key in keys], dtype=float).reshape(len(keys), 12)
+    return {
+        'annual_bill_w_sys': monthly_w_sys.sum(axis=1),
+        'monthly_bill_w_sys': monthly_w_sys,
+        'annual_bill_wo_sys': monthly_wo_sys.sum(axis=1),
+        'monthly_bill_wo_sys': monthly_wo_sys
+    }
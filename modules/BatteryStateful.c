@@ -5,6 +5,8 @@
 
 #include "PySAM_utils.h"
 
+#include "BatteryStateful_eqns.c"
+
 
 /*
  * Controls Group
@@ -2440,8 +2442,15 @@ static PyObject *
 BatteryStateful_setup(CmodStatefulObject *self, PyObject *args)
 {
 	SAM_error error = new_error();
-	self->cmod_ptr = SAM_BatteryStateful_setup(self->data_ptr, &error);
+	SAM_module cmod_ptr = SAM_BatteryStateful_setup(self->data_ptr, &error);
 	if (PySAM_has_error(error )) return NULL;
+	SAM_module old_cmod_ptr = self->cmod_ptr;
+	self->cmod_ptr = cmod_ptr;
+	if (old_cmod_ptr) {
+		error = new_error();
+		SAM_module_destruct(old_cmod_ptr, &error);
+		if (PySAM_has_error(error )) return NULL;
+	}
 	Py_INCREF(Py_None);
 	return Py_None;
 }
@@ -2528,6 +2537,12 @@ static PyMethodDef BatteryStateful_methods[] = {
 				PyDoc_STR("unassign(name) -> None\n Unassign a value in any of the variable groups.")},
 		{"get_data_ptr",           (PyCFunction)BatteryStateful_get_data_ptr,  METH_VARARGS,
 				PyDoc_STR("get_data_ptr() -> Pointer\n Get ssc_data_t pointer")},
+		{"run_steps", (PyCFunction)BatteryStateful_run_steps, METH_VARARGS | METH_KEYWORDS,
+			BatteryStateful_run_steps_doc},
+		{"snapshot", (PyCFunction)BatteryStateful_snapshot, METH_VARARGS | METH_KEYWORDS,
+			BatteryStateful_snapshot_doc},
+		{"restore", (PyCFunction)BatteryStateful_restore, METH_VARARGS | METH_KEYWORDS,
+			BatteryStateful_restore_doc},
 		{NULL,              NULL}           /* sentinel */
 };
 
@@ -2695,6 +2710,8 @@ static PyMethodDef BatteryStatefulModule_methods[] = {
 				PyDoc_STR("wrap(ssc_data_t) -> BatteryStateful\n\nLoad data from a PySSC object.\n\n.. warning::\n\n	Do not call PySSC.data_free on the ssc_data_t provided to ``wrap()``")},
 		{"from_existing",   BatteryStateful_from_existing,        METH_VARARGS,
 				PyDoc_STR("from_existing(data, optional config) -> BatteryStateful\n\nShare data with an existing PySAM class. If ``optional config`` is a valid configuration name, load the module's defaults for that configuration.")},
+		{"step_models", (PyCFunction)BatteryStateful_step_models, METH_VARARGS | METH_KEYWORDS,
+			BatteryStateful_step_models_doc},
 		{NULL,              NULL}           /* sentinel */
 };
 
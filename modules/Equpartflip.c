@@ -5,6 +5,8 @@
 
 #include "PySAM_utils.h"
 
+#include "Equpartflip_eqns.c"
+
 
 /*
  * Revenue Group
@@ -11945,6 +11947,8 @@ static PyMethodDef Equpartflip_methods[] = {
 				PyDoc_STR("unassign(name) -> None\n Unassign a value in any of the variable groups.")},
 		{"get_data_ptr",           (PyCFunction)Equpartflip_get_data_ptr,  METH_VARARGS,
 				PyDoc_STR("get_data_ptr() -> Pointer\n Get ssc_data_t pointer")},
+		{"evaluate_scenarios", (PyCFunction)Equpartflip_evaluate_scenarios, METH_VARARGS | METH_KEYWORDS,
+			Equpartflip_evaluate_scenarios_doc},
 		{NULL,              NULL}           /* sentinel */
 };
 
@@ -331,7 +331,9 @@ Hybrid_execute(CmodObject *self, PyObject *args)
 		return NULL;
 
 	SAM_error error = new_error();
+	Py_BEGIN_ALLOW_THREADS
 	SAM_Hybrid_execute(self->data_ptr, verbosity, &error);
+	Py_END_ALLOW_THREADS
 	if (PySAM_has_error(error )) return NULL;
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -388,7 +390,7 @@ Hybrid_unassign(CmodObject *self, PyObject *args)
 
 static PyMethodDef Hybrid_methods[] = {
 		{"execute",           (PyCFunction)Hybrid_execute,  METH_VARARGS,
-				PyDoc_STR("execute(int verbosity) -> None\n Execute simulation with verbosity level 0 (default) or 1")},
+				PyDoc_STR("execute(int verbosity) -> None\n Execute simulation with verbosity level 0 (default) or 1. The GIL is released during the simulation, so hybrid systems can run concurrently on separate threads")},
 		{"assign",            (PyCFunction)Hybrid_assign,  METH_VARARGS,
 				PyDoc_STR("assign(dict) -> None\n Assign attributes from nested dictionary, except for Outputs\n\n``nested_dict = { 'Common': { var: val, ...}, ...}``")},
 		{"replace",            (PyCFunction)Hybrid_replace,  METH_VARARGS,
@@ -5,6 +5,8 @@
 
 #include "PySAM_utils.h"
 
+#include "IphToLcoefcr_eqns.c"
+
 
 /*
  * IPHLCOH Group
@@ -422,6 +424,8 @@ static PyMethodDef IphToLcoefcr_methods[] = {
 				PyDoc_STR("unassign(name) -> None\n Unassign a value in any of the variable groups.")},
 		{"get_data_ptr",           (PyCFunction)IphToLcoefcr_get_data_ptr,  METH_VARARGS,
 				PyDoc_STR("get_data_ptr() -> Pointer\n Get ssc_data_t pointer")},
+		{"evaluate_arrays", (PyCFunction)IphToLcoefcr_evaluate_arrays, METH_VARARGS | METH_KEYWORDS,
+			IphToLcoefcr_evaluate_arrays_doc},
 		{NULL,              NULL}           /* sentinel */
 };
 
@@ -5,6 +5,8 @@
 
 #include "PySAM_utils.h"
 
+#include "Lcoefcr_eqns.c"
+
 
 /*
  * SimpleLCOE Group
@@ -461,6 +463,8 @@ static PyMethodDef Lcoefcr_methods[] = {
 				PyDoc_STR("unassign(name) -> None\n Unassign a value in any of the variable groups.")},
 		{"get_data_ptr",           (PyCFunction)Lcoefcr_get_data_ptr,  METH_VARARGS,
 				PyDoc_STR("get_data_ptr() -> Pointer\n Get ssc_data_t pointer")},
+		{"evaluate_arrays", (PyCFunction)Lcoefcr_evaluate_arrays, METH_VARARGS | METH_KEYWORDS,
+			Lcoefcr_evaluate_arrays_doc},
 		{NULL,              NULL}           /* sentinel */
 };
 
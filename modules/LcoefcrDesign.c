@@ -5,6 +5,8 @@
 
 #include "PySAM_utils.h"
 
+#include "LcoefcrDesign_eqns.c"
+
 
 /*
  * SystemControl Group
@@ -1079,6 +1081,8 @@ static PyMethodDef LcoefcrDesign_methods[] = {
 				PyDoc_STR("unassign(name) -> None\n Unassign a value in any of the variable groups.")},
 		{"get_data_ptr",           (PyCFunction)LcoefcrDesign_get_data_ptr,  METH_VARARGS,
 				PyDoc_STR("get_data_ptr() -> Pointer\n Get ssc_data_t pointer")},
+		{"evaluate_arrays", (PyCFunction)LcoefcrDesign_evaluate_arrays, METH_VARARGS | METH_KEYWORDS,
+			LcoefcrDesign_evaluate_arrays_doc},
 		{NULL,              NULL}           /* sentinel */
 };
 
@@ -5,6 +5,8 @@
 
 #include "PySAM_utils.h"
 
+#include "Levpartflip_eqns.c"
+
 
 /*
  * Revenue Group
@@ -12299,6 +12301,8 @@ static PyMethodDef Levpartflip_methods[] = {
 				PyDoc_STR("unassign(name) -> None\n Unassign a value in any of the variable groups.")},
 		{"get_data_ptr",           (PyCFunction)Levpartflip_get_data_ptr,  METH_VARARGS,
 				PyDoc_STR("get_data_ptr() -> Pointer\n Get ssc_data_t pointer")},
+		{"evaluate_scenarios", (PyCFunction)Levpartflip_evaluate_scenarios, METH_VARARGS | METH_KEYWORDS,
+			Levpartflip_evaluate_scenarios_doc},
 		{NULL,              NULL}           /* sentinel */
 };
 
@@ -5,6 +5,8 @@
 
 #include "PySAM_utils.h"
 
+#include "Merchantplant_eqns.c"
+
 
 /*
  * FinancialParameters Group
@@ -11552,6 +11554,10 @@ static PyMethodDef Merchantplant_methods[] = {
 				PyDoc_STR("unassign(name) -> None\n Unassign a value in any of the variable groups.")},
 		{"get_data_ptr",           (PyCFunction)Merchantplant_get_data_ptr,  METH_VARARGS,
 				PyDoc_STR("get_data_ptr() -> Pointer\n Get ssc_data_t pointer")},
+		{"evaluate_scenarios", (PyCFunction)Merchantplant_evaluate_scenarios, METH_VARARGS | METH_KEYWORDS,
+			Merchantplant_evaluate_scenarios_doc},
+		{"evaluate_price_paths", (PyCFunction)Merchantplant_evaluate_price_paths, METH_VARARGS | METH_KEYWORDS,
+			Merchantplant_evaluate_price_paths_doc},
 		{NULL,              NULL}           /* sentinel */
 };
 
@@ -5,6 +5,8 @@
 
 #include "PySAM_utils.h"
 
+#include "Saleleaseback_eqns.c"
+
 
 /*
  * Revenue Group
@@ -11456,6 +11458,8 @@ static PyMethodDef Saleleaseback_methods[] = {
 				PyDoc_STR("unassign(name) -> None\n Unassign a value in any of the variable groups.")},
 		{"get_data_ptr",           (PyCFunction)Saleleaseback_get_data_ptr,  METH_VARARGS,
 				PyDoc_STR("get_data_ptr() -> Pointer\n Get ssc_data_t pointer")},
+		{"evaluate_scenarios", (PyCFunction)Saleleaseback_evaluate_scenarios, METH_VARARGS | METH_KEYWORDS,
+			Saleleaseback_evaluate_scenarios_doc},
 		{NULL,              NULL}           /* sentinel */
 };
 
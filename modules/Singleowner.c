@@ -5,6 +5,8 @@
 
 #include "PySAM_utils.h"
 
+#include "Singleowner_eqns.c"
+
 
 /*
  * Revenue Group
@@ -12755,6 +12757,8 @@ static PyMethodDef Singleowner_methods[] = {
 				PyDoc_STR("unassign(name) -> None\n Unassign a value in any of the variable groups.")},
 		{"get_data_ptr",           (PyCFunction)Singleowner_get_data_ptr,  METH_VARARGS,
 				PyDoc_STR("get_data_ptr() -> Pointer\n Get ssc_data_t pointer")},
+		{"evaluate_scenarios", (PyCFunction)Singleowner_evaluate_scenarios, METH_VARARGS | METH_KEYWORDS,
+			Singleowner_evaluate_scenarios_doc},
 		{NULL,              NULL}           /* sentinel */
 };
 
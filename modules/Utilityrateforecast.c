@@ -5,6 +5,8 @@
 
 #include "PySAM_utils.h"
 
+#include "Utilityrateforecast_eqns.c"
+
 
 /*
  * ElectricityRates Group
@@ -1132,8 +1134,15 @@ static PyObject *
 Utilityrateforecast_setup(CmodStatefulObject *self, PyObject *args)
 {
 	SAM_error error = new_error();
-	self->cmod_ptr = SAM_Utilityrateforecast_setup(self->data_ptr, &error);
+	SAM_module cmod_ptr = SAM_Utilityrateforecast_setup(self->data_ptr, &error);
 	if (PySAM_has_error(error )) return NULL;
+	SAM_module old_cmod_ptr = self->cmod_ptr;
+	self->cmod_ptr = cmod_ptr;
+	if (old_cmod_ptr) {
+		error = new_error();
+		SAM_module_destruct(old_cmod_ptr, &error);
+		if (PySAM_has_error(error )) return NULL;
+	}
 	Py_INCREF(Py_None);
 	return Py_None;
 }
@@ -1220,6 +1229,8 @@ static PyMethodDef Utilityrateforecast_methods[] = {
 				PyDoc_STR("unassign(name) -> None\n Unassign a value in any of the variable groups.")},
 		{"get_data_ptr",           (PyCFunction)Utilityrateforecast_get_data_ptr,  METH_VARARGS,
 				PyDoc_STR("get_data_ptr() -> Pointer\n Get ssc_data_t pointer")},
+		{"evaluate_candidates", (PyCFunction)Utilityrateforecast_evaluate_candidates, METH_VARARGS | METH_KEYWORDS,
+			Utilityrateforecast_evaluate_candidates_doc},
 		{NULL,              NULL}           /* sentinel */
 };
 
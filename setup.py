@@ -123,6 +123,8 @@ for filename in os.listdir(defaults_df_dir):
 stub_files = []
 shutil.copyfile(os.path.join(this_directory, "stubs", 'AdjustmentFactors.pyi'),
                 os.path.join(this_directory, 'stubs', 'stubs', 'AdjustmentFactors.pyi'))
+shutil.copyfile(os.path.join(this_directory, "stubs", 'DataTables.pyi'),
+                os.path.join(this_directory, 'stubs', 'stubs', 'DataTables.pyi'))
 for filename in os.listdir(os.path.join(this_directory, "stubs", "stubs")):
     if ".pyi" not in filename:
         continue
@@ -147,6 +149,15 @@ extension_modules = [Extension('PySAM.AdjustmentFactors',
                     libraries=libs,
                     extra_compile_args=extra_compile_args,
                     extra_link_args=extra_link_args
+                    ),
+                     Extension('PySAM.DataTables',
+                     ['src/DataTables.c'],
+                    define_macros=defines,
+                    include_dirs=[srcpath, includepath, this_directory + "/src"],
+                    library_dirs=[libpath],
+                    libraries=libs,
+                    extra_compile_args=extra_compile_args,
+                    extra_link_args=extra_link_args
                     )]
 
 for filename in os.listdir(this_directory + "/modules"):
@@ -0,0 +1,280 @@
+#define BATTERYSTATEFUL_N_TRAJECTORIES 6
+
+static const char* BatteryStateful_trajectory_names[BATTERYSTATEFUL_N_TRAJECTORIES] = {
+        "SOC", "P", "I", "V", "T_batt", "Q_max"
+};
+
+char BatteryStateful_run_steps_doc[] =
+        "run_steps(inputs, control_mode=None) -> dict\n"
+        "Run one timestep per value of ``inputs`` in a single call, without returning to Python between timesteps.\n\n"
+        "``inputs`` is a sequence or buffer, such as a numpy array, of ``Controls.input_current`` [A] if ``control_mode`` is 0, "
+        "or of ``Controls.input_power`` [kW] if ``control_mode`` is 1. If ``control_mode`` is not provided, ``Controls.control_mode`` is used.\n"
+        "``setup()`` must be called first. The state after the last timestep is available in StatePack and StateCell as after ``execute()``.\n\n"
+        "Returns a dictionary of the StatePack trajectories SOC, P, I, V, T_batt and Q_max, each a memoryview of doubles with one value per timestep, "
+        "which can be converted without copying with ``numpy.asarray``.\n\n"
+        "The GIL is released while the timesteps run, so different BatteryStateful objects can run on different threads.";
+
+static PyObject* BatteryStateful_run_steps(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    CmodStatefulObject* self_obj = (CmodStatefulObject*)self;
+    SAM_table data = self_obj->data_ptr;
+
+    PyObject* inputs_obj = NULL;
+    PyObject* control_mode_obj = Py_None;
+    static char *kwlist[] = {"inputs", "control_mode", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|O:run_steps", kwlist, &inputs_obj, &control_mode_obj))
+        return NULL;
+
+    if (!self_obj->cmod_ptr){
+        PyErr_SetString(PyExc_Exception, "BatteryStateful error: setup() must be called before run_steps()");
+        return NULL;
+    }
+
+    SAM_error error = new_error();
+    int control_mode;
+    if (control_mode_obj == Py_None){
+        control_mode = (int)SAM_table_get_num(data, "control_mode", &error);
+        if (PySAM_has_error(error))
+            return NULL;
+    }
+    else{
+        error_destruct(error);
+        control_mode = (int)PyLong_AsLong(control_mode_obj);
+        if (PyErr_Occurred())
+            return NULL;
+    }
+    if (control_mode != 0 && control_mode != 1){
+        PyErr_SetString(PyExc_ValueError, "BatteryStateful error: control_mode must be 0 for current or 1 for power");
+        return NULL;
+    }
+    const char* input_name = control_mode == 0 ? "input_current" : "input_power";
+
+    double* inputs = NULL;
+    int n;
+    if (PySAM_buffer_to_array(inputs_obj, &inputs, &n) < 0)
+        return NULL;
+
+    PyObject* result = PyDict_New();
+    double* trajectories[BATTERYSTATEFUL_N_TRAJECTORIES];
+    int i, j;
+    if (!result)
+        goto fail;
+    for (j = 0; j < BATTERYSTATEFUL_N_TRAJECTORIES; j++){
+        PyObject* buffer = PySAM_new_double_buffer(n, &trajectories[j]);
+        if (!buffer)
+            goto fail;
+        int set = PyDict_SetItemString(result, BatteryStateful_trajectory_names[j], buffer);
+        Py_DECREF(buffer);
+        if (set < 0)
+            goto fail;
+    }
+
+    error = new_error();
+    SAM_table_set_num(data, "control_mode", control_mode, &error);
+    if (PySAM_has_error(error))
+        goto fail;
+
+    error = new_error();
+    Py_BEGIN_ALLOW_THREADS
+    for (i = 0; i < n; i++){
+        SAM_table_set_num(data, input_name, inputs[i], &error);
+        if (PySAM_error_occurred(error))
+            break;
+        SAM_stateful_module_exec(self_obj->cmod_ptr, data, 0, &error);
+        if (PySAM_error_occurred(error))
+            break;
+        for (j = 0; j < BATTERYSTATEFUL_N_TRAJECTORIES; j++)
+            trajectories[j][i] = SAM_table_get_num(data, BatteryStateful_trajectory_names[j], &error);
+        if (PySAM_error_occurred(error))
+            break;
+    }
+    Py_END_ALLOW_THREADS
+    if (PySAM_has_error(error))
+        goto fail;
+
+    free(inputs);
+    return result;
+
+    fail:
+    free(inputs);
+    Py_XDECREF(result);
+    return NULL;
+}
+
+static PyTypeObject BatteryStateful_Type;
+
+char BatteryStateful_step_models_doc[] =
+        "step_models(models, commands, states, control_mode=1) -> None\n"
+        "Run a sequence of BatteryStateful models through their commands in a single call, such as the batteries of a fleet.\n\n"
+        "``commands`` is a matrix, such as a 2-D numpy array, with one row per model and one column per timestep, of "
+        "``Controls.input_current`` [A] if ``control_mode`` is 0, or of ``Controls.input_power`` [kW] if ``control_mode`` is 1. "
+        "Each model must have had ``setup()`` called.\n\n"
+        "``states`` is a sequence of six writable buffers of doubles, such as numpy float64 arrays, with one value per model, "
+        "into which the StatePack values SOC, P, I, V, T_batt and Q_max after the last timestep are written.\n\n"
+        "The GIL is released while all the models run, so different sequences of models can run on different threads.";
+
+static PyObject* BatteryStateful_step_models(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    PyObject *models_obj = NULL, *commands_obj = NULL, *states_obj = NULL;
+    int control_mode = 1;
+    static char *kwlist[] = {"models", "commands", "states", "control_mode", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OOO|i:step_models", kwlist, &models_obj, &commands_obj, &states_obj, &control_mode))
+        return NULL;
+    if (control_mode != 0 && control_mode != 1){
+        PyErr_SetString(PyExc_ValueError, "BatteryStateful error: control_mode must be 0 for current or 1 for power");
+        return NULL;
+    }
+    const char* input_name = control_mode == 0 ? "input_current" : "input_power";
+
+    PyObject* models = PySequence_Fast(models_obj, "models must be a sequence of BatteryStateful");
+    if (!models)
+        return NULL;
+    PyObject* states = PySequence_Fast(states_obj, "states must be a sequence of buffers");
+    if (!states){
+        Py_DECREF(models);
+        return NULL;
+    }
+
+    Py_ssize_t n_models = PySequence_Fast_GET_SIZE(models);
+    Py_buffer views[BATTERYSTATEFUL_N_TRAJECTORIES];
+    double* state_values[BATTERYSTATEFUL_N_TRAJECTORIES];
+    SAM_table* data = NULL;
+    SAM_module* cmods = NULL;
+    double* commands = NULL;
+    PyObject* result = NULL;
+    int n_views = 0, n_rows, n_steps, i, j, t;
+    SAM_error error = NULL;
+
+    if (PySequence_Fast_GET_SIZE(states) != BATTERYSTATEFUL_N_TRAJECTORIES){
+        PyErr_Format(PyExc_ValueError, "BatteryStateful error: states must have %d buffers", BATTERYSTATEFUL_N_TRAJECTORIES);
+        goto done;
+    }
+    for (; n_views < BATTERYSTATEFUL_N_TRAJECTORIES; n_views++){
+        if (PyObject_GetBuffer(PySequence_Fast_GET_ITEM(states, n_views), &views[n_views],
+                               PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0)
+            goto done;
+        if (views[n_views].ndim != 1 || !views[n_views].format || strcmp(views[n_views].format, "d") != 0
+            || views[n_views].len != n_models * (Py_ssize_t)sizeof(double)){
+            PyErr_Format(PyExc_ValueError, "BatteryStateful error: states must be buffers of %zd doubles", n_models);
+            PyBuffer_Release(&views[n_views]);
+            goto done;
+        }
+        state_values[n_views] = (double*)views[n_views].buf;
+    }
+
+    if (PySAM_buffer_to_matrix(commands_obj, &commands, &n_rows, &n_steps) < 0)
+        goto done;
+    if (n_rows != n_models){
+        PyErr_Format(PyExc_ValueError, "BatteryStateful error: commands has %d rows for %zd models", n_rows, n_models);
+        goto done;
+    }
+
+    data = malloc((n_models > 0 ? n_models : 1) * sizeof(SAM_table));
+    cmods = malloc((n_models > 0 ? n_models : 1) * sizeof(SAM_module));
+    if (!data || !cmods){
+        PyErr_NoMemory();
+        goto done;
+    }
+    for (i = 0; i < n_models; i++){
+        PyObject* model = PySequence_Fast_GET_ITEM(models, i);
+        if (!PyObject_TypeCheck(model, &BatteryStateful_Type)){
+            PyErr_SetString(PyExc_TypeError, "BatteryStateful error: models must be BatteryStateful");
+            goto done;
+        }
+        data[i] = ((CmodStatefulObject*)model)->data_ptr;
+        cmods[i] = ((CmodStatefulObject*)model)->cmod_ptr;
+        if (!cmods[i]){
+            PyErr_Format(PyExc_Exception, "BatteryStateful error: setup() must be called on model %d before step_models()", i);
+            goto done;
+        }
+    }
+
+    error = new_error();
+    Py_BEGIN_ALLOW_THREADS
+    for (i = 0; i < n_models && !PySAM_error_occurred(error); i++){
+        SAM_table_set_num(data[i], "control_mode", control_mode, &error);
+        for (t = 0; t < n_steps && !PySAM_error_occurred(error); t++){
+            SAM_table_set_num(data[i], input_name, commands[(size_t)i * n_steps + t], &error);
+            if (!PySAM_error_occurred(error))
+                SAM_stateful_module_exec(cmods[i], data[i], 0, &error);
+        }
+        for (j = 0; j < BATTERYSTATEFUL_N_TRAJECTORIES && !PySAM_error_occurred(error); j++)
+            state_values[j][i] = SAM_table_get_num(data[i], BatteryStateful_trajectory_names[j], &error);
+    }
+    Py_END_ALLOW_THREADS
+    if (PySAM_has_error(error))
+        goto done;
+
+    Py_INCREF(Py_None);
+    result = Py_None;
+
+    done:
+    for (j = 0; j < n_views; j++)
+        PyBuffer_Release(&views[j]);
+    free(commands);
+    free(data);
+    free(cmods);
+    Py_DECREF(states);
+    Py_DECREF(models);
+    return result;
+}
+
+static const char* BatteryStateful_state_groups[] = {"StatePack", "StateCell", NULL};
+
+static PyObject* BatteryStateful_state_names = NULL;
+
+static void BatteryStateful_snapshot_destruct(PyObject *capsule){
+    SAM_table snapshot = (SAM_table)PyCapsule_GetPointer(capsule, "BatteryStateful.snapshot");
+    if (snapshot)
+        SAM_table_destruct(snapshot, NULL);
+}
+
+char BatteryStateful_snapshot_doc[] =
+        "snapshot() -> handle\n"
+        "Copy the battery state, which is all the StatePack and StateCell variables including the lifetime, thermal and loss states, into an opaque handle.\n"
+        "The handle can be passed to ``restore`` any number of times, on this model or another BatteryStateful with the same parameters, "
+        "to branch simulations from the same starting state.";
+
+static PyObject* BatteryStateful_snapshot(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    CmodStatefulObject* self_obj = (CmodStatefulObject*)self;
+
+    if (!BatteryStateful_state_names){
+        BatteryStateful_state_names = PySAM_group_var_names(self_obj->x_attr, BatteryStateful_state_groups);
+        if (!BatteryStateful_state_names)
+            return NULL;
+    }
+
+    SAM_table snapshot = SAM_table_construct(NULL);
+    if (PySAM_table_copy_entries(self_obj->data_ptr, snapshot, BatteryStateful_state_names) < 0){
+        SAM_table_destruct(snapshot, NULL);
+        return NULL;
+    }
+    return PyCapsule_New(snapshot, "BatteryStateful.snapshot", BatteryStateful_snapshot_destruct);
+}
+
+char BatteryStateful_restore_doc[] =
+        "restore(handle) -> None\n"
+        "Replace the battery state with a state copied by ``snapshot``. The next ``execute`` or ``run_steps`` continues from the restored state.";
+
+static PyObject* BatteryStateful_restore(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    CmodStatefulObject* self_obj = (CmodStatefulObject*)self;
+
+    PyObject* handle = NULL;
+    static char *kwlist[] = {"handle", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O:restore", kwlist, &handle))
+        return NULL;
+
+    if (!PyCapsule_IsValid(handle, "BatteryStateful.snapshot")){
+        PyErr_SetString(PyExc_TypeError, "BatteryStateful error: restore() requires a handle from snapshot()");
+        return NULL;
+    }
+    SAM_table snapshot = (SAM_table)PyCapsule_GetPointer(handle, "BatteryStateful.snapshot");
+
+    if (PySAM_table_copy_entries(snapshot, self_obj->data_ptr, NULL) < 0)
+        return NULL;
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
@@ -0,0 +1,527 @@
+#include <Python.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <SAM_api.h>
+
+#include "PySAM_utils.h"
+
+
+/*
+ * Access to variables of SAM data tables by name, for the sub-system tables of PySAM.Hybrids and for PySAM.PipelineTools.
+ * Tables are passed as the integer pointers returned by `get_data_ptr()`.
+ */
+
+static PyObject *
+DataTables_get_number(PyObject *self, PyObject *args)
+{
+    long long int ptr = 0;
+    char* name = 0;
+    if (!PyArg_ParseTuple(args, "Ls:get_number", &ptr, &name))
+        return NULL;
+
+    SAM_error error = new_error();
+    double value = SAM_table_get_num((SAM_table)ptr, name, &error);
+    if (PySAM_has_error(error))
+        return NULL;
+    return PyFloat_FromDouble(value);
+}
+
+static PyObject *
+DataTables_set_number(PyObject *self, PyObject *args)
+{
+    long long int ptr = 0;
+    char* name = 0;
+    double value;
+    if (!PyArg_ParseTuple(args, "Lsd:set_number", &ptr, &name, &value))
+        return NULL;
+
+    SAM_error error = new_error();
+    SAM_table_set_num((SAM_table)ptr, name, value, &error);
+    if (PySAM_has_error(error))
+        return NULL;
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyObject *
+DataTables_get_array(PyObject *self, PyObject *args)
+{
+    long long int ptr = 0;
+    char* name = 0;
+    if (!PyArg_ParseTuple(args, "Ls:get_array", &ptr, &name))
+        return NULL;
+
+    int n = 0, i;
+    SAM_error error = new_error();
+    const double* arr = SAM_table_get_array((SAM_table)ptr, name, &n, &error);
+    if (PySAM_has_error(error))
+        return NULL;
+
+    PyObject* seq = PyTuple_New(n);
+    if (!seq)
+        return NULL;
+    for (i = 0; i < n; i++){
+        PyObject* item = PyFloat_FromDouble(arr[i]);
+        if (!item){
+            Py_DECREF(seq);
+            return NULL;
+        }
+        PyTuple_SET_ITEM(seq, i, item);
+    }
+    return seq;
+}
+
+static PyObject *
+DataTables_set_array(PyObject *self, PyObject *args)
+{
+    long long int ptr = 0;
+    char* name = 0;
+    PyObject* value;
+    if (!PyArg_ParseTuple(args, "LsO:set_array", &ptr, &name, &value))
+        return NULL;
+
+    double* arr = NULL;
+    int n;
+    if (PyNumber_Check(value) && !PyObject_CheckBuffer(value)){
+        n = 1;
+        arr = malloc(sizeof(double));
+        if (!arr)
+            return PyErr_NoMemory();
+        arr[0] = PyFloat_AsDouble(value);
+        if (PyErr_Occurred()){
+            free(arr);
+            return NULL;
+        }
+    }
+    else if (PySAM_buffer_to_array(value, &arr, &n) < 0)
+        return NULL;
+
+    SAM_error error = new_error();
+    SAM_table_set_array((SAM_table)ptr, name, arr, n, &error);
+    free(arr);
+    if (PySAM_has_error(error))
+        return NULL;
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyObject *
+DataTables_get_table(PyObject *self, PyObject *args)
+{
+    long long int ptr = 0;
+    char* name = 0;
+    if (!PyArg_ParseTuple(args, "Ls:get_table", &ptr, &name))
+        return NULL;
+
+    SAM_error error = new_error();
+    SAM_table table = SAM_table_get_table((SAM_table)ptr, name, &error);
+    if (PySAM_error_occurred(error) || !table){
+        error_destruct(error);
+        Py_INCREF(Py_None);
+        return Py_None;
+    }
+    error_destruct(error);
+    return PyLong_FromVoidPtr((void*)table);
+}
+
+static PyObject *
+DataTables_set_table(PyObject *self, PyObject *args)
+{
+    long long int ptr = 0, table_ptr = 0;
+    char* name = 0;
+    if (!PyArg_ParseTuple(args, "LsL:set_table", &ptr, &name, &table_ptr))
+        return NULL;
+
+    SAM_error error = new_error();
+    SAM_table_set_table((SAM_table)ptr, name, (SAM_table)table_ptr, &error);
+    if (PySAM_has_error(error))
+        return NULL;
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyObject *
+DataTables_new_table(PyObject *self, PyObject *args)
+{
+    long long int ptr = 0;
+    char* name = 0;
+    if (!PyArg_ParseTuple(args, "Ls:new_table", &ptr, &name))
+        return NULL;
+
+    SAM_error error = new_error();
+    SAM_table empty = SAM_table_construct(&error);
+    if (PySAM_has_error(error))
+        return NULL;
+    error = new_error();
+    SAM_table_set_table((SAM_table)ptr, name, empty, &error);
+    SAM_table_destruct(empty, NULL);
+    if (PySAM_has_error(error))
+        return NULL;
+
+    error = new_error();
+    SAM_table table = SAM_table_get_table((SAM_table)ptr, name, &error);
+    if (PySAM_has_error(error))
+        return NULL;
+    return PyLong_FromVoidPtr((void*)table);
+}
+
+#define DataTables_FNV_PRIME 1099511628211ULL
+
+/// FNV-1a hash of `len` bytes, continuing from `h`, taken over 8-byte words in four interleaved lanes so the
+/// multiplies don't wait on each other and arrays hash at about the speed of copying them
+static uint64_t DataTables_hash_bytes(uint64_t h, const void* data, size_t len){
+    const unsigned char* p = (const unsigned char*)data;
+    uint64_t w[4], a = h, b = h ^ 0x9e3779b97f4a7c15ULL, c = h ^ 0xbf58476d1ce4e5b9ULL, d = h ^ 0x94d049bb133111ebULL;
+    size_t i = 0;
+    if (len >= 32){
+        for (; i + 32 <= len; i += 32){
+            memcpy(w, p + i, 32);
+            a = (a ^ w[0]) * DataTables_FNV_PRIME;
+            b = (b ^ w[1]) * DataTables_FNV_PRIME;
+            c = (c ^ w[2]) * DataTables_FNV_PRIME;
+            d = (d ^ w[3]) * DataTables_FNV_PRIME;
+        }
+        h = (a * DataTables_FNV_PRIME) ^ b;
+        h = (h * DataTables_FNV_PRIME) ^ c;
+        h = ((h * DataTables_FNV_PRIME) ^ d) * DataTables_FNV_PRIME;
+    }
+    for (; i + 8 <= len; i += 8){
+        memcpy(w, p + i, 8);
+        h = (h ^ w[0]) * DataTables_FNV_PRIME;
+    }
+    for (; i < len; i++)
+        h = (h ^ p[i]) * DataTables_FNV_PRIME;
+    return h;
+}
+
+#define DataTables_HASH_SEED 14695981039346656037ULL
+
+static int DataTables_hash_table(SAM_table table, PyObject* names, PyObject* exclude, uint64_t* h);
+
+/// 1 if `key` is in the set `names`, or `names` is NULL, and isn't in the set `exclude`, 0 if not, -1 on error
+static int DataTables_selected(const char* key, PyObject* names, PyObject* exclude){
+    if (!names && !exclude)
+        return 1;
+    PyObject* key_obj = PyUnicode_FromString(key);
+    if (!key_obj)
+        return -1;
+    int selected = names ? PySet_Contains(names, key_obj) : 1;
+    if (selected > 0 && exclude){
+        selected = PySet_Contains(exclude, key_obj);
+        if (selected >= 0)
+            selected = !selected;
+    }
+    Py_DECREF(key_obj);
+    return selected;
+}
+
+static int DataTables_hash_var(SAM_var var, uint64_t* h){
+    const char* str;
+    const double* arr;
+    double num;
+    uint64_t sub;
+    int n = 0, m = 0, i, j;
+
+    SAM_error error = new_error();
+    int type = SAM_var_query(var, &error);
+    if (PySAM_has_error(error)) return -1;
+    *h = DataTables_hash_bytes(*h, &type, sizeof(int));
+
+    error = new_error();
+    switch (type){
+        case SAM_STRING:
+            str = SAM_var_get_string(var, &error);
+            if (PySAM_has_error(error)) return -1;
+            *h = DataTables_hash_bytes(*h, str, strlen(str) + 1);
+            break;
+        case SAM_NUMBER:
+            num = SAM_var_get_number(var, &error);
+            if (PySAM_has_error(error)) return -1;
+            *h = DataTables_hash_bytes(*h, &num, sizeof(double));
+            break;
+        case SAM_ARRAY:
+            arr = SAM_var_get_arr(var, &n, &error);
+            if (PySAM_has_error(error)) return -1;
+            *h = DataTables_hash_bytes(*h, &n, sizeof(int));
+            *h = DataTables_hash_bytes(*h, arr, n * sizeof(double));
+            break;
+        case SAM_MATRIX:
+            arr = SAM_var_get_mat(var, &n, &m, &error);
+            if (PySAM_has_error(error)) return -1;
+            *h = DataTables_hash_bytes(*h, &n, sizeof(int));
+            *h = DataTables_hash_bytes(*h, &m, sizeof(int));
+            *h = DataTables_hash_bytes(*h, arr, n * m * sizeof(double));
+            break;
+        case SAM_TABLE:
+            if (DataTables_hash_table(SAM_var_get_table(var, &error), NULL, NULL, &sub) < 0) return -1;
+            *h = DataTables_hash_bytes(*h, &sub, sizeof(uint64_t));
+            break;
+        case SAM_DATARR:
+            SAM_var_size(var, &n, NULL, &error);
+            if (PySAM_has_error(error)) return -1;
+            for (i = 0; i < n; i++){
+                error = new_error();
+                SAM_var v = SAM_var_get_datarr(var, i, &error);
+                if (PySAM_has_error(error) || DataTables_hash_var(v, h) < 0) return -1;
+            }
+            break;
+        case SAM_DATMAT:
+            SAM_var_size(var, &n, &m, &error);
+            if (PySAM_has_error(error)) return -1;
+            for (i = 0; i < n; i++){
+                for (j = 0; j < m; j++){
+                    error = new_error();
+                    SAM_var v = SAM_var_get_datmat(var, i, j, &error);
+                    if (PySAM_has_error(error) || DataTables_hash_var(v, h) < 0) return -1;
+                }
+            }
+            break;
+        default:
+            break;
+    }
+    return 0;
+}
+
+/// hash of the names, types and values of the entries of a table named in the set `names`, or all of them if `names`
+/// is NULL, except those named in the set `exclude`, including nested tables and data arrays. Entries are hashed
+/// separately and summed, so the hash doesn't depend on the order the table stores them in
+static int DataTables_hash_table(SAM_table table, PyObject* names, PyObject* exclude, uint64_t* h){
+    const char* str;
+    const double* arr;
+    double num;
+    SAM_table sub_table;
+    SAM_var var;
+    uint64_t entry, sub;
+    int size, s, type, n = 0, m = 0;
+
+    *h = 0;
+    SAM_error error = new_error();
+    size = SAM_table_size(table, &error);
+    if (PySAM_has_error(error)) return -1;
+
+    for (s = 0; s < size; s++){
+        error = new_error();
+        const char* key = SAM_table_key(table, s, &type, &error);
+        if (PySAM_has_error(error)) return -1;
+        int selected = DataTables_selected(key, names, exclude);
+        if (selected < 0) return -1;
+        if (!selected) continue;
+        entry = DataTables_hash_bytes(DataTables_HASH_SEED, key, strlen(key) + 1);
+        entry = DataTables_hash_bytes(entry, &type, sizeof(int));
+
+        error = new_error();
+        switch (type){
+            case SAM_STRING:
+                str = SAM_table_get_string(table, key, &error);
+                if (PySAM_has_error(error)) return -1;
+                entry = DataTables_hash_bytes(entry, str, strlen(str) + 1);
+                break;
+            case SAM_NUMBER:
+                num = SAM_table_get_num(table, key, &error);
+                if (PySAM_has_error(error)) return -1;
+                entry = DataTables_hash_bytes(entry, &num, sizeof(double));
+                break;
+            case SAM_ARRAY:
+                arr = SAM_table_get_array(table, key, &n, &error);
+                if (PySAM_has_error(error)) return -1;
+                entry = DataTables_hash_bytes(entry, &n, sizeof(int));
+                entry = DataTables_hash_bytes(entry, arr, n * sizeof(double));
+                break;
+            case SAM_MATRIX:
+                arr = SAM_table_get_matrix(table, key, &n, &m, &error);
+                if (PySAM_has_error(error)) return -1;
+                entry = DataTables_hash_bytes(entry, &n, sizeof(int));
+                entry = DataTables_hash_bytes(entry, &m, sizeof(int));
+                entry = DataTables_hash_bytes(entry, arr, n * m * sizeof(double));
+                break;
+            case SAM_TABLE:
+                sub_table = SAM_table_get_table(table, key, &error);
+                if (PySAM_has_error(error) || DataTables_hash_table(sub_table, NULL, NULL, &sub) < 0) return -1;
+                entry = DataTables_hash_bytes(entry, &sub, sizeof(uint64_t));
+                break;
+            case SAM_DATARR:
+                var = SAM_table_get_datarr(table, key, &n, &error);
+                if (PySAM_has_error(error) || DataTables_hash_var(var, &entry) < 0) return -1;
+                break;
+            case SAM_DATMAT:
+                var = SAM_table_get_datmat(table, key, &n, &m, &error);
+                if (PySAM_has_error(error) || DataTables_hash_var(var, &entry) < 0) return -1;
+                break;
+            default:
+                break;
+        }
+        *h += entry;
+    }
+    return 0;
+}
+
+/// frozenset of the names in `names`, or NULL for None, in `*set`
+static int DataTables_name_set(PyObject* names, PyObject** set){
+    *set = NULL;
+    if (!names || names == Py_None)
+        return 0;
+    if (PyFrozenSet_Check(names)){
+        Py_INCREF(names);
+        *set = names;
+        return 0;
+    }
+    *set = PyFrozenSet_New(names);
+    return *set ? 0 : -1;
+}
+
+static PyObject *
+DataTables_fingerprint(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    long long int ptr = 0;
+    PyObject *names = NULL, *exclude = NULL;
+    static char *kwlist[] = {"data_ptr", "names", "exclude", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "L|OO:fingerprint", kwlist, &ptr, &names, &exclude))
+        return NULL;
+
+    PyObject *names_set = NULL, *exclude_set = NULL;
+    if (DataTables_name_set(names, &names_set) < 0 || DataTables_name_set(exclude, &exclude_set) < 0){
+        Py_XDECREF(names_set);
+        return NULL;
+    }
+
+    uint64_t h;
+    int status = DataTables_hash_table((SAM_table)ptr, names_set, exclude_set, &h);
+    Py_XDECREF(names_set);
+    Py_XDECREF(exclude_set);
+    if (status < 0)
+        return NULL;
+    return PyLong_FromUnsignedLongLong(h);
+}
+
+static PyObject *
+DataTables_copy_entries(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    long long int src = 0, dst = 0;
+    PyObject *exclude = NULL, *exclude_set = NULL;
+    static char *kwlist[] = {"src_ptr", "dst_ptr", "exclude", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "LL|O:copy_entries", kwlist, &src, &dst, &exclude))
+        return NULL;
+    if (DataTables_name_set(exclude, &exclude_set) < 0)
+        return NULL;
+
+    const char* key;
+    const char* str;
+    const double* arr;
+    int size, s, n, m, type, selected;
+    SAM_error error = new_error();
+    size = SAM_table_size((SAM_table)src, &error);
+    if (PySAM_has_error(error))
+        goto fail;
+
+    for (s = 0; s < size; s++){
+        error = new_error();
+        key = SAM_table_key((SAM_table)src, s, &type, &error);
+        if (PySAM_has_error(error))
+            goto fail;
+        selected = DataTables_selected(key, NULL, exclude_set);
+        if (selected < 0)
+            goto fail;
+        if (!selected)
+            continue;
+
+        error = new_error();
+        switch (type){
+            case SAM_STRING:
+                str = SAM_table_get_string((SAM_table)src, key, &error);
+                if (!PySAM_error_occurred(error))
+                    SAM_table_set_string((SAM_table)dst, key, str, &error);
+                break;
+            case SAM_NUMBER:
+                SAM_table_set_num((SAM_table)dst, key, SAM_table_get_num((SAM_table)src, key, &error), &error);
+                break;
+            case SAM_ARRAY:
+                arr = SAM_table_get_array((SAM_table)src, key, &n, &error);
+                if (!PySAM_error_occurred(error))
+                    SAM_table_set_array((SAM_table)dst, key, (double*)arr, n, &error);
+                break;
+            case SAM_MATRIX:
+                arr = SAM_table_get_matrix((SAM_table)src, key, &n, &m, &error);
+                if (!PySAM_error_occurred(error))
+                    SAM_table_set_matrix((SAM_table)dst, key, (double*)arr, n, m, &error);
+                break;
+            case SAM_TABLE:
+                SAM_table_set_table((SAM_table)dst, key, SAM_table_get_table((SAM_table)src, key, &error), &error);
+                break;
+            default:
+                // the SAM C API has no setters for data arrays and data matrices, which compute modules don't output
+                break;
+        }
+        if (PySAM_has_error(error))
+            goto fail;
+    }
+    Py_XDECREF(exclude_set);
+    Py_INCREF(Py_None);
+    return Py_None;
+
+    fail:
+    Py_XDECREF(exclude_set);
+    return NULL;
+}
+
+static PyMethodDef DataTablesModule_methods[] = {
+        {"get_number",      DataTables_get_number,      METH_VARARGS,
+                PyDoc_STR("get_number(data_ptr, name) -> float\n Get a number from a data table")},
+        {"set_number",      DataTables_set_number,      METH_VARARGS,
+                PyDoc_STR("set_number(data_ptr, name, value) -> None\n Set a number in a data table")},
+        {"get_array",       DataTables_get_array,       METH_VARARGS,
+                PyDoc_STR("get_array(data_ptr, name) -> tuple\n Get an array from a data table")},
+        {"set_array",       DataTables_set_array,       METH_VARARGS,
+                PyDoc_STR("set_array(data_ptr, name, value) -> None\n Set an array in a data table from a sequence, a buffer such as a numpy array, or a number")},
+        {"get_table",       DataTables_get_table,       METH_VARARGS,
+                PyDoc_STR("get_table(data_ptr, name) -> Union[int, None]\n Get the pointer to a table inside a data table, or None if it is not assigned")},
+        {"set_table",       DataTables_set_table,       METH_VARARGS,
+                PyDoc_STR("set_table(data_ptr, name, table_ptr) -> None\n Copy a data table into a data table")},
+        {"new_table",       DataTables_new_table,       METH_VARARGS,
+                PyDoc_STR("new_table(data_ptr, name) -> int\n Assign an empty table inside a data table and get its pointer")},
+        {"fingerprint",     (PyCFunction)DataTables_fingerprint,     METH_VARARGS | METH_KEYWORDS,
+                PyDoc_STR("fingerprint(data_ptr, names=None, exclude=None) -> int\n Hash of the names and values of the entries of a data table named in ``names``, or of all entries, except those named in ``exclude``")},
+        {"copy_entries",    (PyCFunction)DataTables_copy_entries,    METH_VARARGS | METH_KEYWORDS,
+                PyDoc_STR("copy_entries(src_ptr, dst_ptr, exclude=None) -> None\n Copy the entries of a data table into another, except those named in ``exclude``")},
+        {NULL,              NULL}           /* sentinel */
+};
+
+PyDoc_STRVAR(module_doc,
+             "Access to SAM data tables by name, for PySAM.Hybrids and PySAM.PipelineTools.");
+
+
+static int
+DataTablesModule_exec(PyObject *m)
+{
+	if (PySAM_load_lib(m) < 0) goto fail;
+
+    return 0;
+    fail:
+    Py_XDECREF(m);
+    return -1;
+}
+
+static struct PyModuleDef_Slot DataTablesModule_slots[] = {
+        {Py_mod_exec, DataTablesModule_exec},
+        {0, NULL},
+};
+
+static struct PyModuleDef DataTablesModule = {
+        PyModuleDef_HEAD_INIT,
+        "DataTables",
+        module_doc,
+        0,
+        DataTablesModule_methods,
+        DataTablesModule_slots,
+        NULL,
+        NULL,
+        NULL
+};
+
+/* Export function for the module (*must* be called PyInit_DataTables) */
+
+PyMODINIT_FUNC
+PyInit_DataTables(void)
+{
+    return PyModuleDef_Init(&DataTablesModule);
+}
@@ -0,0 +1,16 @@
+char Equpartflip_evaluate_scenarios_doc[] =
+        "evaluate_scenarios(inputs, outputs) -> dict\n"
+        "Execute the model once for each scenario of number inputs, e.g. ``evaluate_scenarios({'ppa_price_input': prices, 'total_installed_cost': costs}, ['lcoe_real', 'sponsor_aftertax_npv', 'tax_investor_aftertax_irr'])``.\n\n"
+        "``inputs`` is a dictionary of input names to a sequence or buffer, such as a numpy array, with one value per scenario. "
+        "Inputs that are arrays, such as ``ppa_price_input``, are set to the single value of each scenario. "
+        "All other inputs, including ``gen`` and the cost and tax inputs, keep their current values. The scenario inputs and ``Outputs`` are restored afterwards, so ``Outputs`` still holds the results of the last ``execute``.\n\n"
+        "Returns a dictionary of each name in ``outputs``, which must be number outputs, to a memoryview of doubles with one value per scenario, "
+        "which can be converted without copying with ``numpy.asarray``.\n\n"
+        "Each scenario is a full run of the compute module, so the cost grows linearly with the number of scenarios; the call only saves the Python overhead of each run. "
+        "The GIL is released while the scenarios run.";
+
+static PyObject* Equpartflip_evaluate_scenarios(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    CmodObject* self_obj = (CmodObject*)self;
+    return PySAM_evaluate_scenarios(self_obj->data_ptr, self_obj->x_attr, "equpartflip", "Equpartflip", args, keywds);
+}
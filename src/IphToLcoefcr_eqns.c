@@ -0,0 +1,46 @@
+#define IPHTOLCOEFCR_N_ARGS 3
+
+static const char* IphToLcoefcr_array_names[IPHTOLCOEFCR_N_ARGS] = {
+        "fixed_operating_cost", "electricity_rate", "annual_electricity_consumption"
+};
+
+char IphToLcoefcr_evaluate_arrays_doc[] =
+        "evaluate_arrays(fixed_operating_cost=None, electricity_rate=None, annual_electricity_consumption=None) -> memoryview\n"
+        "Calculate the ``fixed_operating_cost`` including the cost of electricity for many points in one call without running the compute module, "
+        "for ``Lcoefcr.evaluate_arrays``.\n\n"
+        "Each argument is a sequence or buffer, such as a numpy array, with one value per point, or a number for all points. "
+        "Arguments that are None use the value assigned in the model. All sequences must have the same length.\n\n"
+        "Returns a memoryview of doubles of ``fixed_operating_cost + electricity_rate * annual_electricity_consumption`` for each point, "
+        "which can be converted without copying with ``numpy.asarray``. The model's ``fixed_operating_cost`` is not changed.\n\n"
+        "The GIL is released during the calculation.";
+
+static PyObject* IphToLcoefcr_evaluate_arrays(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    CmodObject* self_obj = (CmodObject*)self;
+
+    PyObject* objs[IPHTOLCOEFCR_N_ARGS] = {Py_None, Py_None, Py_None};
+    static char *kwlist[] = {"fixed_operating_cost", "electricity_rate", "annual_electricity_consumption", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "|OOO:evaluate_arrays", kwlist, &objs[0], &objs[1], &objs[2]))
+        return NULL;
+
+    double* arrays[IPHTOLCOEFCR_N_ARGS] = {NULL};
+    PyObject* result = NULL;
+    int n, i;
+    if (PySAM_broadcast_arrays(self_obj->data_ptr, "IphToLcoefcr", objs, IphToLcoefcr_array_names, IPHTOLCOEFCR_N_ARGS, arrays, &n) < 0)
+        goto done;
+
+    double* fixed_operating_cost;
+    result = PySAM_new_double_buffer(n, &fixed_operating_cost);
+    if (!result)
+        goto done;
+
+    Py_BEGIN_ALLOW_THREADS
+    for (i = 0; i < n; i++)
+        fixed_operating_cost[i] = arrays[0][i] + arrays[1][i] * arrays[2][i];
+    Py_END_ALLOW_THREADS
+
+    done:
+    for (i = 0; i < IPHTOLCOEFCR_N_ARGS; i++)
+        free(arrays[i]);
+    return result;
+}
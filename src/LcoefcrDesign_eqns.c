@@ -0,0 +1,90 @@
+#define LCOEFCRDESIGN_N_ARGS 6
+
+static const char* LcoefcrDesign_array_names[LCOEFCRDESIGN_N_ARGS] = {
+        "annual_energy", "total_installed_cost", "fixed_operating_cost", "variable_operating_cost",
+        "electricity_rate", "annual_electricity_consumption"
+};
+
+/// fixed charge rate of the model, input or calculated by running the compute module for the design only
+static int LcoefcrDesign_fixed_charge_rate(SAM_table data, double* fcr){
+    SAM_error error = new_error();
+    double fcr_input_option = SAM_table_get_num(data, "ui_fcr_input_option", &error);
+    if (PySAM_has_error(error))
+        return -1;
+
+    error = new_error();
+    if (fcr_input_option == 0){
+        *fcr = SAM_table_get_num(data, "ui_fixed_charge_rate", &error);
+        return PySAM_has_error(error) ? -1 : 0;
+    }
+
+    double sim_type = SAM_table_get_num(data, "sim_type", &error);
+    int sim_type_assigned = !PySAM_error_occurred(error);
+    error_destruct(error);
+
+    error = new_error();
+    SAM_table_set_num(data, "sim_type", 2, &error);
+    if (!PySAM_error_occurred(error))
+        SAM_module_exec("lcoefcr_design", data, 0, &error);
+    if (!PySAM_error_occurred(error))
+        *fcr = SAM_table_get_num(data, "fixed_charge_rate_calc", &error);
+
+    if (sim_type_assigned)
+        SAM_table_set_num(data, "sim_type", sim_type, NULL);
+    else
+        SAM_table_unassign_entry(data, "sim_type", NULL);
+    return PySAM_has_error(error) ? -1 : 0;
+}
+
+char LcoefcrDesign_evaluate_arrays_doc[] =
+        "evaluate_arrays(annual_energy=None, total_installed_cost=None, fixed_operating_cost=None, variable_operating_cost=None, "
+        "electricity_rate=None, annual_electricity_consumption=None) -> memoryview\n"
+        "Calculate ``lcoe_fcr`` for many points, such as the pixels of a map, in one call.\n\n"
+        "Each argument is a sequence or buffer, such as a numpy array, with one value per point, or a number for all points. "
+        "Arguments that are None use the value assigned in the model. All sequences must have the same length. "
+        "The fixed charge rate is the same for all points: ``ui_fixed_charge_rate``, or if ``ui_fcr_input_option`` is 1, "
+        "``fixed_charge_rate_calc`` from one run of the compute module for the design only.\n\n"
+        "Returns a memoryview of doubles of ``lcoe_fcr`` [$/kWh] for each point, "
+        "``(fcr * total_installed_cost + fixed_operating_cost + electricity_rate * annual_electricity_consumption) / annual_energy + variable_operating_cost``, "
+        "which can be converted without copying with ``numpy.asarray``.\n\n"
+        "The GIL is released during the calculation.";
+
+static PyObject* LcoefcrDesign_evaluate_arrays(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    CmodObject* self_obj = (CmodObject*)self;
+
+    PyObject* objs[LCOEFCRDESIGN_N_ARGS] = {Py_None, Py_None, Py_None, Py_None, Py_None, Py_None};
+    static char *kwlist[] = {"annual_energy", "total_installed_cost", "fixed_operating_cost", "variable_operating_cost",
+                             "electricity_rate", "annual_electricity_consumption", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "|OOOOOO:evaluate_arrays", kwlist,
+                                     &objs[0], &objs[1], &objs[2], &objs[3], &objs[4], &objs[5]))
+        return NULL;
+
+    double fcr;
+    if (LcoefcrDesign_fixed_charge_rate(self_obj->data_ptr, &fcr) < 0)
+        return NULL;
+
+    double* arrays[LCOEFCRDESIGN_N_ARGS] = {NULL};
+    PyObject* result = NULL;
+    int n, i;
+    if (PySAM_broadcast_arrays(self_obj->data_ptr, "LcoefcrDesign", objs, LcoefcrDesign_array_names, LCOEFCRDESIGN_N_ARGS, arrays, &n) < 0)
+        goto done;
+
+    double* lcoe_fcr;
+    result = PySAM_new_double_buffer(n, &lcoe_fcr);
+    if (!result)
+        goto done;
+
+    const double *annual_energy = arrays[0], *total_installed_cost = arrays[1], *fixed_operating_cost = arrays[2],
+            *variable_operating_cost = arrays[3], *electricity_rate = arrays[4], *annual_electricity_consumption = arrays[5];
+    Py_BEGIN_ALLOW_THREADS
+    for (i = 0; i < n; i++)
+        lcoe_fcr[i] = (fcr * total_installed_cost[i] + fixed_operating_cost[i] + electricity_rate[i] * annual_electricity_consumption[i])
+                / annual_energy[i] + variable_operating_cost[i];
+    Py_END_ALLOW_THREADS
+
+    done:
+    for (i = 0; i < LCOEFCRDESIGN_N_ARGS; i++)
+        free(arrays[i]);
+    return result;
+}
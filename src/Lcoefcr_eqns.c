@@ -0,0 +1,53 @@
+#define LCOEFCR_N_ARGS 5
+
+static const char* Lcoefcr_array_names[LCOEFCR_N_ARGS] = {
+        "annual_energy", "capital_cost", "fixed_charge_rate", "fixed_operating_cost", "variable_operating_cost"
+};
+
+/// lcoe_fcr as computed by the lcoefcr compute module, for each element
+static void Lcoefcr_lcoe_fcr(int n, const double* annual_energy, const double* capital_cost, const double* fixed_charge_rate,
+                             const double* fixed_operating_cost, const double* variable_operating_cost, double* lcoe_fcr){
+    int i;
+    for (i = 0; i < n; i++)
+        lcoe_fcr[i] = (fixed_charge_rate[i] * capital_cost[i] + fixed_operating_cost[i]) / annual_energy[i] + variable_operating_cost[i];
+}
+
+char Lcoefcr_evaluate_arrays_doc[] =
+        "evaluate_arrays(annual_energy=None, capital_cost=None, fixed_charge_rate=None, fixed_operating_cost=None, variable_operating_cost=None) -> memoryview\n"
+        "Calculate ``lcoe_fcr`` for many points, such as the pixels of a map, in one call without running the compute module.\n\n"
+        "Each argument is a sequence or buffer, such as a numpy array, with one value per point, or a number for all points. "
+        "Arguments that are None use the value assigned in SimpleLCOE. All sequences must have the same length.\n\n"
+        "Returns a memoryview of doubles of ``lcoe_fcr`` [$/kWh] for each point, "
+        "``(fixed_charge_rate * capital_cost + fixed_operating_cost) / annual_energy + variable_operating_cost``, "
+        "which can be converted without copying with ``numpy.asarray``.\n\n"
+        "The GIL is released during the calculation.";
+
+static PyObject* Lcoefcr_evaluate_arrays(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    CmodObject* self_obj = (CmodObject*)self;
+
+    PyObject* objs[LCOEFCR_N_ARGS] = {Py_None, Py_None, Py_None, Py_None, Py_None};
+    static char *kwlist[] = {"annual_energy", "capital_cost", "fixed_charge_rate", "fixed_operating_cost", "variable_operating_cost", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "|OOOOO:evaluate_arrays", kwlist, &objs[0], &objs[1], &objs[2], &objs[3], &objs[4]))
+        return NULL;
+
+    double* arrays[LCOEFCR_N_ARGS] = {NULL};
+    PyObject* result = NULL;
+    int n, i;
+    if (PySAM_broadcast_arrays(self_obj->data_ptr, "Lcoefcr", objs, Lcoefcr_array_names, LCOEFCR_N_ARGS, arrays, &n) < 0)
+        goto done;
+
+    double* lcoe_fcr;
+    result = PySAM_new_double_buffer(n, &lcoe_fcr);
+    if (!result)
+        goto done;
+
+    Py_BEGIN_ALLOW_THREADS
+    Lcoefcr_lcoe_fcr(n, arrays[0], arrays[1], arrays[2], arrays[3], arrays[4], lcoe_fcr);
+    Py_END_ALLOW_THREADS
+
+    done:
+    for (i = 0; i < LCOEFCR_N_ARGS; i++)
+        free(arrays[i]);
+    return result;
+}
@@ -0,0 +1,163 @@
+char Merchantplant_evaluate_scenarios_doc[] =
+        "evaluate_scenarios(inputs, outputs) -> dict\n"
+        "Execute the model once for each scenario of number inputs, e.g. ``evaluate_scenarios({'total_installed_cost': costs, 'debt_percent': debt}, ['lcoe_real', 'project_return_aftertax_npv', 'project_return_aftertax_irr'])``.\n\n"
+        "``inputs`` is a dictionary of input names to a sequence or buffer, such as a numpy array, with one value per scenario. "
+        "Inputs that are arrays, such as ``ppa_price_input``, are set to the single value of each scenario. "
+        "All other inputs, including ``gen`` and the cost and tax inputs, keep their current values. The scenario inputs and ``Outputs`` are restored afterwards, so ``Outputs`` still holds the results of the last ``execute``.\n\n"
+        "Returns a dictionary of each name in ``outputs``, which must be number outputs, to a memoryview of doubles with one value per scenario, "
+        "which can be converted without copying with ``numpy.asarray``.\n\n"
+        "Each scenario is a full run of the compute module, so the cost grows linearly with the number of scenarios; the call only saves the Python overhead of each run. "
+        "The GIL is released while the scenarios run.";
+
+static PyObject* Merchantplant_evaluate_scenarios(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    CmodObject* self_obj = (CmodObject*)self;
+    return PySAM_evaluate_scenarios(self_obj->data_ptr, self_obj->x_attr, "merchantplant", "Merchantplant", args, keywds);
+}
+
+char Merchantplant_evaluate_price_paths_doc[] =
+        "evaluate_price_paths(prices, outputs, name='mp_energy_market_revenue_single') -> dict\n"
+        "Run the model once for each path of market prices in one call, e.g. for stochastic price paths.\n\n"
+        "``prices`` is a matrix, such as a 2-D numpy array, with one row per path of prices [$/MWh] at the time steps of ``name``, "
+        "which is one of the single-column price inputs ``mp_energy_market_revenue_single`` or ``mp_ancserv1_revenue_single`` to ``mp_ancserv4_revenue_single``. "
+        "The revenue from ``name`` and its percent of generation option, ``mp_enable_market_percent_gen`` or ``mp_enable_ancserv1_percent_gen`` to ``mp_enable_ancserv4_percent_gen``, "
+        "must be enabled, otherwise the prices aren't used and ValueError is raised. All other inputs keep their current values for every path. ``name`` is restored afterwards.\n\n"
+        "Returns a dictionary of each name in ``outputs``, which must be number outputs such as ``project_return_aftertax_npv``, ``project_return_aftertax_irr`` and ``min_dscr``, "
+        "to a memoryview of doubles with one value per path, which can be converted without copying with ``numpy.asarray``.\n\n"
+        "The GIL is released while the paths run, so different Merchantplant objects can run paths on different threads.";
+
+static PyObject* Merchantplant_evaluate_price_paths(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    CmodObject* self_obj = (CmodObject*)self;
+    SAM_table data = self_obj->data_ptr;
+
+    PyObject* prices_obj = NULL;
+    PyObject* outputs_obj = NULL;
+    const char* name = "mp_energy_market_revenue_single";
+    static char *kwlist[] = {"prices", "outputs", "name", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "OO|s:evaluate_price_paths", kwlist, &prices_obj, &outputs_obj, &name))
+        return NULL;
+
+    // the single-column price input is only read when its revenue and its percent of generation option are enabled
+    char enable[32], enable_percent[48];
+    int service = 0;
+    if (strcmp(name, "mp_energy_market_revenue_single") == 0){
+        strcpy(enable, "mp_enable_energy_market_revenue");
+        strcpy(enable_percent, "mp_enable_market_percent_gen");
+    }
+    else if (sscanf(name, "mp_ancserv%d_revenue_single", &service) == 1 && service >= 1 && service <= 4
+             && strlen(name) == strlen("mp_ancserv1_revenue_single")){
+        sprintf(enable, "mp_enable_ancserv%d", service);
+        sprintf(enable_percent, "mp_enable_ancserv%d_percent_gen", service);
+    }
+    else {
+        PyErr_Format(PyExc_ValueError, "Merchantplant error: %s is not a single-column price input", name);
+        return NULL;
+    }
+    const char* flags[] = {enable, enable_percent};
+    int f;
+    for (f = 0; f < 2; f++){
+        SAM_error flag_error = new_error();
+        double flag = SAM_table_get_num(data, flags[f], &flag_error);
+        int unassigned = PySAM_error_occurred(flag_error);
+        error_destruct(flag_error);
+        if (unassigned || flag != 1){
+            PyErr_Format(PyExc_ValueError, "Merchantplant error: %s must be 1 for the prices of %s to be used", flags[f], name);
+            return NULL;
+        }
+    }
+
+    PyObject* outputs_seq = PySequence_Fast(outputs_obj, "outputs must be a sequence of output names");
+    if (!outputs_seq)
+        return NULL;
+    Py_ssize_t n_outputs = PySequence_Fast_GET_SIZE(outputs_seq);
+
+    double* prices = NULL;
+    int n_paths, n_steps, i, j;
+    const char** output_names = calloc(n_outputs + 1, sizeof(char*));
+    double** output_values = calloc(n_outputs + 1, sizeof(double*));
+    PyObject* result = PyDict_New();
+    PyObject* names = PySet_New(NULL);
+    SAM_table saved = NULL;
+    int restore = 0;
+    SAM_error error;
+
+    if (!result || !names)
+        goto fail;
+    if (!output_names || !output_values){
+        PyErr_NoMemory();
+        goto fail;
+    }
+
+    if (PySAM_buffer_to_matrix(prices_obj, &prices, &n_paths, &n_steps) < 0)
+        goto fail;
+
+    for (j = 0; j < n_outputs; j++){
+        output_names[j] = PyUnicode_AsUTF8(PySequence_Fast_GET_ITEM(outputs_seq, j));
+        if (!output_names[j])
+            goto fail;
+        PyObject* buffer = PySAM_new_double_buffer(n_paths, &output_values[j]);
+        if (!buffer)
+            goto fail;
+        int set = PyDict_SetItemString(result, output_names[j], buffer);
+        Py_DECREF(buffer);
+        if (set < 0)
+            goto fail;
+    }
+
+    PyObject* name_obj = PyUnicode_FromString(name);
+    if (!name_obj)
+        goto fail;
+    int added = PySet_Add(names, name_obj);
+    Py_DECREF(name_obj);
+    if (added < 0)
+        goto fail;
+    saved = SAM_table_construct(NULL);
+    if (!saved){
+        PyErr_NoMemory();
+        goto fail;
+    }
+    if (PySAM_table_copy_entries(data, saved, names) < 0)
+        goto fail;
+    restore = 1;
+
+    error = new_error();
+    Py_BEGIN_ALLOW_THREADS
+    for (i = 0; i < n_paths; i++){
+        SAM_table_set_matrix(data, name, &prices[i * n_steps], n_steps, 1, &error);
+        if (PySAM_error_occurred(error))
+            break;
+        SAM_module_exec("merchantplant", data, 0, &error);
+        if (PySAM_error_occurred(error))
+            break;
+        for (j = 0; j < n_outputs; j++){
+            output_values[j][i] = SAM_table_get_num(data, output_names[j], &error);
+            if (PySAM_error_occurred(error))
+                break;
+        }
+        if (PySAM_error_occurred(error))
+            break;
+    }
+    Py_END_ALLOW_THREADS
+    if (PySAM_has_error(error))
+        goto fail;
+    goto done;
+
+    fail:
+    Py_CLEAR(result);
+
+    done:
+    if (restore){
+        SAM_table_unassign_entry(data, name, NULL);
+        if (PySAM_table_copy_entries(saved, data, NULL) < 0)
+            Py_CLEAR(result);
+    }
+    if (saved)
+        SAM_table_destruct(saved, NULL);
+    free(prices);
+    free(output_names);
+    free(output_values);
+    Py_XDECREF(names);
+    Py_DECREF(outputs_seq);
+    return result;
+}
@@ -75,6 +75,12 @@ static int PySAM_has_error(SAM_error error){
     return 0;
 }
 
+/// checks for an error without setting a Python exception, so it can be called while the GIL is released
+static int PySAM_error_occurred(SAM_error error){
+    const char* cc = error_message(error);
+    return (cc != NULL) && (cc[0] != '\0');
+}
+
 static int PySAM_has_error_msg(SAM_error error, const char *msg){
     const char* cc = error_message(error);
     if ((cc != NULL) && (cc[0] != '\0')) {
@@ -293,6 +299,365 @@ static int PySAM_seq_to_matrix(PyObject *value, double **mat, int *nrows, int *n
     return 0;
 }
 
+/// Like PySAM_seq_to_array, but copies C-contiguous buffers of doubles such as numpy float64 arrays in one memcpy
+static int PySAM_buffer_to_array(PyObject *value, double **arr, int *seqlen){
+    if (PyObject_CheckBuffer(value)){
+        Py_buffer view;
+        if (PyObject_GetBuffer(value, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == 0){
+            if (view.ndim <= 1 && view.format && strcmp(view.format, "d") == 0){
+                *seqlen = (int)(view.len / sizeof(double));
+                *arr = malloc(view.len > 0 ? view.len : 1);
+                if (!*arr){
+                    PyBuffer_Release(&view);
+                    PyErr_NoMemory();
+                    return -2;
+                }
+                memcpy(*arr, view.buf, view.len);
+                PyBuffer_Release(&view);
+                return 0;
+            }
+            PyBuffer_Release(&view);
+        }
+        else
+            PyErr_Clear();
+    }
+    return PySAM_seq_to_array(value, arr, seqlen);
+}
+
+/// Like PySAM_seq_to_matrix, but copies C-contiguous 2-D buffers of doubles such as numpy float64 arrays in one memcpy
+static int PySAM_buffer_to_matrix(PyObject *value, double **mat, int *nrows, int *ncols){
+    if (PyObject_CheckBuffer(value)){
+        Py_buffer view;
+        if (PyObject_GetBuffer(value, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == 0){
+            if (view.ndim == 2 && view.format && strcmp(view.format, "d") == 0){
+                *nrows = (int)view.shape[0];
+                *ncols = (int)view.shape[1];
+                *mat = malloc(view.len > 0 ? view.len : 1);
+                if (!*mat){
+                    PyBuffer_Release(&view);
+                    PyErr_NoMemory();
+                    return -2;
+                }
+                memcpy(*mat, view.buf, view.len);
+                PyBuffer_Release(&view);
+                return 0;
+            }
+            PyBuffer_Release(&view);
+        }
+        else
+            PyErr_Clear();
+    }
+    return PySAM_seq_to_matrix(value, mat, nrows, ncols);
+}
+
+/// returns new reference to a memoryview of `n` doubles backed by a new bytearray, with `data` pointing to its storage
+static PyObject* PySAM_new_double_buffer(Py_ssize_t n, double **data){
+    PyObject* bytes = PyByteArray_FromStringAndSize(NULL, n * (Py_ssize_t)sizeof(double));
+    if (!bytes)
+        return NULL;
+    *data = (double*)PyByteArray_AS_STRING(bytes);
+
+    PyObject* view = PyMemoryView_FromObject(bytes);
+    Py_DECREF(bytes);
+    if (!view)
+        return NULL;
+    PyObject* doubles = PyObject_CallMethod(view, "cast", "s", "d");
+    Py_DECREF(view);
+    return doubles;
+}
+
+/// returns new reference to a set of the variable names in the groups `group_names` of a PySAM object's attribute dictionary
+static PyObject* PySAM_group_var_names(PyObject* x_attr, const char** group_names){
+    PyObject* names = PySet_New(NULL);
+    if (!names)
+        return NULL;
+    for (; *group_names; group_names++){
+        PyObject* group = PyDict_GetItemString(x_attr, *group_names);
+        if (!group){
+            PyErr_Format(PyExc_KeyError, "Group %s not found", *group_names);
+            Py_DECREF(names);
+            return NULL;
+        }
+        PyGetSetDef* getset = Py_TYPE(group)->tp_getset;
+        for (; getset && getset->name; getset++){
+            PyObject* name = PyUnicode_FromString(getset->name);
+            if (!name || PySet_Add(names, name) < 0){
+                Py_XDECREF(name);
+                Py_DECREF(names);
+                return NULL;
+            }
+            Py_DECREF(name);
+        }
+    }
+    return names;
+}
+
+/// copies the numbers, strings, arrays and matrices of `src` named in the set `names`, or all of them if `names` is NULL, into `dst`
+static int PySAM_table_copy_entries(SAM_table src, SAM_table dst, PyObject* names){
+    const char* str;
+    const double* arr;
+    int size, s, n, m, type;
+
+    SAM_error error = new_error();
+    size = SAM_table_size(src, &error);
+    if (PySAM_has_error(error)) return -1;
+
+    for (s = 0; s < size; s++){
+        error = new_error();
+        const char* key = SAM_table_key(src, s, &type, &error);
+        if (PySAM_has_error(error)) return -1;
+        if (names){
+            PyObject* key_obj = PyUnicode_FromString(key);
+            int contains = PySet_Contains(names, key_obj);
+            Py_DECREF(key_obj);
+            if (contains < 0) return -1;
+            if (!contains) continue;
+        }
+
+        error = new_error();
+        switch (type){
+            case SAM_STRING:
+                str = SAM_table_get_string(src, key, &error);
+                if (!PySAM_error_occurred(error))
+                    SAM_table_set_string(dst, key, str, &error);
+                break;
+            case SAM_NUMBER:
+                SAM_table_set_num(dst, key, SAM_table_get_num(src, key, &error), &error);
+                break;
+            case SAM_ARRAY:
+                arr = SAM_table_get_array(src, key, &n, &error);
+                if (!PySAM_error_occurred(error))
+                    SAM_table_set_array(dst, key, (double*)arr, n, &error);
+                break;
+            case SAM_MATRIX:
+                arr = SAM_table_get_matrix(src, key, &n, &m, &error);
+                if (!PySAM_error_occurred(error))
+                    SAM_table_set_matrix(dst, key, (double*)arr, n, m, &error);
+                break;
+            default:
+                break;
+        }
+        if (PySAM_has_error(error)) return -1;
+    }
+    return 0;
+}
+
+/// for the evaluate_scenarios method of financial models: runs the compute module `cmod` on `data` once per scenario,
+/// with the number inputs in the dict `inputs` of name to one value per scenario, and returns a dict of the number
+/// outputs named in `outputs` to a memoryview of one value per scenario. Inputs that are arrays, such as ppa_price_input,
+/// are set to a single value. Each scenario is a full run of the compute module; the loop only saves the Python round trip
+/// per run. The inputs and the Outputs group named in `x_attr` are restored after the scenarios, so the model's outputs
+/// still match its inputs, and the GIL is released while they run
+static PyObject* PySAM_evaluate_scenarios(SAM_table data, PyObject* x_attr, const char* cmod, const char* tech, PyObject *args, PyObject *keywds){
+    PyObject* inputs_obj = NULL;
+    PyObject* outputs_obj = NULL;
+    static char *kwlist[] = {"inputs", "outputs", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O!O:evaluate_scenarios", kwlist, &PyDict_Type, &inputs_obj, &outputs_obj))
+        return NULL;
+
+    PyObject* outputs_seq = PySequence_Fast(outputs_obj, "outputs must be a sequence of output names");
+    if (!outputs_seq)
+        return NULL;
+
+    Py_ssize_t n_inputs = PyDict_Size(inputs_obj);
+    Py_ssize_t n_outputs = PySequence_Fast_GET_SIZE(outputs_seq);
+    const char** input_names = calloc(n_inputs + 1, sizeof(char*));
+    double** input_values = calloc(n_inputs + 1, sizeof(double*));
+    int* input_is_array = calloc(n_inputs + 1, sizeof(int));
+    const char** output_names = calloc(n_outputs + 1, sizeof(char*));
+    double** output_values = calloc(n_outputs + 1, sizeof(double*));
+    PyObject* result = PyDict_New();
+    PyObject* names = PySet_New(NULL);
+    PyObject* output_group_names = PySAM_group_var_names(x_attr, (const char*[]){"Outputs", NULL});
+    SAM_table saved = NULL;
+    int n_scenarios = -1, n, i, j, restore = 0;
+    SAM_error error;
+
+    if (!result || !names || !output_group_names)
+        goto fail;
+    if (!input_names || !input_values || !input_is_array || !output_names || !output_values){
+        PyErr_NoMemory();
+        goto fail;
+    }
+
+    PyObject *key, *value;
+    Py_ssize_t pos = 0;
+    j = 0;
+    while (PyDict_Next(inputs_obj, &pos, &key, &value)){
+        input_names[j] = PyUnicode_AsUTF8(key);
+        if (!input_names[j])
+            goto fail;
+        if (PySAM_buffer_to_array(value, &input_values[j], &n) < 0)
+            goto fail;
+        if (n_scenarios >= 0 && n != n_scenarios){
+            PyErr_Format(PyExc_ValueError, "%s error: input %s has %d values but other inputs have %d", tech, input_names[j], n, n_scenarios);
+            goto fail;
+        }
+        n_scenarios = n;
+        error = new_error();
+        SAM_table_get_array(data, input_names[j], &n, &error);
+        input_is_array[j] = !PySAM_error_occurred(error);
+        error_destruct(error);
+        if (PySet_Add(names, key) < 0)
+            goto fail;
+        j++;
+    }
+    if (n_scenarios < 0){
+        PyErr_Format(PyExc_ValueError, "%s error: evaluate_scenarios requires at least one input", tech);
+        goto fail;
+    }
+
+    for (j = 0; j < n_outputs; j++){
+        output_names[j] = PyUnicode_AsUTF8(PySequence_Fast_GET_ITEM(outputs_seq, j));
+        if (!output_names[j])
+            goto fail;
+        PyObject* buffer = PySAM_new_double_buffer(n_scenarios, &output_values[j]);
+        if (!buffer)
+            goto fail;
+        int set = PyDict_SetItemString(result, output_names[j], buffer);
+        Py_DECREF(buffer);
+        if (set < 0)
+            goto fail;
+    }
+
+    error = new_error();
+    saved = SAM_table_construct(&error);
+    if (PySAM_has_error(error))
+        goto fail;
+    if (PySAM_table_copy_entries(data, saved, names) < 0)
+        goto fail;
+    if (PySAM_table_copy_entries(data, saved, output_group_names) < 0)
+        goto fail;
+    restore = 1;
+
+    error = new_error();
+    Py_BEGIN_ALLOW_THREADS
+    for (i = 0; i < n_scenarios; i++){
+        for (j = 0; j < n_inputs; j++){
+            if (input_is_array[j])
+                SAM_table_set_array(data, input_names[j], &input_values[j][i], 1, &error);
+            else
+                SAM_table_set_num(data, input_names[j], input_values[j][i], &error);
+            if (PySAM_error_occurred(error))
+                break;
+        }
+        if (PySAM_error_occurred(error))
+            break;
+        SAM_module_exec(cmod, data, 0, &error);
+        if (PySAM_error_occurred(error))
+            break;
+        for (j = 0; j < n_outputs; j++){
+            output_values[j][i] = SAM_table_get_num(data, output_names[j], &error);
+            if (PySAM_error_occurred(error))
+                break;
+        }
+        if (PySAM_error_occurred(error))
+            break;
+    }
+    Py_END_ALLOW_THREADS
+    if (PySAM_has_error(error))
+        goto fail;
+    goto done;
+
+    fail:
+    Py_CLEAR(result);
+
+    done:
+    if (restore){
+        for (j = 0; j < n_inputs; j++)
+            SAM_table_unassign_entry(data, input_names[j], NULL);
+        PyObject* exc_type, *exc_value, *exc_tb;
+        PyErr_Fetch(&exc_type, &exc_value, &exc_tb);
+        PyObject* iter = PyObject_GetIter(output_group_names);
+        PyObject* output_name;
+        while (iter && (output_name = PyIter_Next(iter))){
+            const char* name = PyUnicode_AsUTF8(output_name);
+            if (name)
+                SAM_table_unassign_entry(data, name, NULL);
+            Py_DECREF(output_name);
+        }
+        Py_XDECREF(iter);
+        if (PyErr_Occurred() || PySAM_table_copy_entries(saved, data, NULL) < 0){
+            Py_XDECREF(exc_type);
+            Py_XDECREF(exc_value);
+            Py_XDECREF(exc_tb);
+            Py_CLEAR(result);
+        }
+        else
+            PyErr_Restore(exc_type, exc_value, exc_tb);
+    }
+    if (saved)
+        SAM_table_destruct(saved, NULL);
+    if (input_values){
+        for (j = 0; j < n_inputs; j++)
+            free(input_values[j]);
+    }
+    free(input_names);
+    free(input_values);
+    free(input_is_array);
+    free(output_names);
+    free(output_values);
+    Py_XDECREF(names);
+    Py_XDECREF(output_group_names);
+    Py_DECREF(outputs_seq);
+    return result;
+}
+
+/// for the evaluate_arrays methods of closed-form models: converts each of the `n_args` objects, which may be a number,
+/// a sequence or buffer of doubles such as a numpy array, or None for the number `names[i]` in `data`, into `arrays[i]`
+/// of the common length `*n`. Numbers are repeated so the evaluation loops run over contiguous arrays without branches.
+/// `arrays` must be zeroed by the caller, which frees them
+static int PySAM_broadcast_arrays(SAM_table data, const char* tech, PyObject** objs, const char** names, int n_args, double** arrays, int* n){
+    double* scalars = malloc(n_args * sizeof(double));
+    int i, j, len;
+    *n = -1;
+    if (!scalars){
+        PyErr_NoMemory();
+        return -1;
+    }
+    for (i = 0; i < n_args; i++){
+        if (objs[i] == Py_None){
+            SAM_error error = new_error();
+            scalars[i] = SAM_table_get_num(data, names[i], &error);
+            if (PySAM_has_error(error))
+                goto fail;
+        }
+        else if (PyNumber_Check(objs[i]) && !PyObject_CheckBuffer(objs[i])){
+            scalars[i] = PyFloat_AsDouble(objs[i]);
+            if (PyErr_Occurred())
+                goto fail;
+        }
+        else{
+            if (PySAM_buffer_to_array(objs[i], &arrays[i], &len) < 0)
+                goto fail;
+            if (*n >= 0 && len != *n){
+                PyErr_Format(PyExc_ValueError, "%s error: %s has %d values but other arrays have %d", tech, names[i], len, *n);
+                goto fail;
+            }
+            *n = len;
+        }
+    }
+    if (*n < 0)
+        *n = 1;
+    for (i = 0; i < n_args; i++){
+        if (arrays[i])
+            continue;
+        arrays[i] = malloc((*n > 0 ? *n : 1) * sizeof(double));
+        if (!arrays[i]){
+            PyErr_NoMemory();
+            goto fail;
+        }
+        for (j = 0; j < *n; j++)
+            arrays[i][j] = scalars[i];
+    }
+    free(scalars);
+    return 0;
+
+    fail:
+    free(scalars);
+    return -1;
+}
+
 static PyObject* PySAM_table_to_dict(SAM_table table);
 
 static PyObject* SAM_var_to_PyObject(SAM_var var){
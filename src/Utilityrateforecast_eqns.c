@@ -0,0 +1,140 @@
+static const char* Utilityrateforecast_state_names[] = {"ur_energy_use", "ur_dc_peaks", "grid_power", "idx", NULL};
+
+/// restores a matrix of the tariff state saved in `state`, or unassigns it if it was not assigned, without the GIL
+static void Utilityrateforecast_restore_matrix(SAM_table data, const char* name, const double* mat, int nrows, int ncols, SAM_error* error){
+    if (mat)
+        SAM_table_set_matrix(data, name, (double*)mat, nrows, ncols, error);
+    else
+        SAM_table_unassign_entry(data, name, error);
+}
+
+char Utilityrateforecast_evaluate_candidates_doc[] =
+        "evaluate_candidates(grid_power, idx=None) -> memoryview\n"
+        "Forecast the cost of each row of ``grid_power``, a matrix of candidate grid power profiles [kW] with one row per candidate, in one call.\n\n"
+        "Every candidate starts from the current tariff state, including the energy use and demand peaks so far this month in "
+        "``ElectricityRates.ur_energy_use`` and ``ElectricityRates.ur_dc_peaks``, and the forecast window starts at ``idx``, default ``Controls.idx``. "
+        "The tariff state, ``grid_power`` and ``idx`` are left as they were before the call, so the chosen candidate can then be run with ``execute``.\n"
+        "``setup()`` must be called first.\n\n"
+        "Returns a memoryview of doubles of ``ur_total_bill`` for each candidate, which can be converted without copying with ``numpy.asarray``.\n\n"
+        "The GIL is released while the candidates run.";
+
+static PyObject* Utilityrateforecast_evaluate_candidates(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    CmodStatefulObject* self_obj = (CmodStatefulObject*)self;
+    SAM_table data = self_obj->data_ptr;
+
+    PyObject* grid_power_obj = NULL;
+    PyObject* idx_obj = Py_None;
+    static char *kwlist[] = {"grid_power", "idx", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|O:evaluate_candidates", kwlist, &grid_power_obj, &idx_obj))
+        return NULL;
+
+    if (!self_obj->cmod_ptr){
+        PyErr_SetString(PyExc_Exception, "Utilityrateforecast error: setup() must be called before evaluate_candidates()");
+        return NULL;
+    }
+
+    double* candidates = NULL;
+    int n_candidates, n_steps;
+    if (PySAM_buffer_to_matrix(grid_power_obj, &candidates, &n_candidates, &n_steps) < 0)
+        return NULL;
+
+    SAM_table state = NULL;
+    PyObject* names = PySet_New(NULL);
+    if (!names)
+        goto fail;
+    const char** name;
+    for (name = Utilityrateforecast_state_names; *name; name++){
+        PyObject* name_obj = PyUnicode_FromString(*name);
+        if (!name_obj || PySet_Add(names, name_obj) < 0){
+            Py_XDECREF(name_obj);
+            Py_DECREF(names);
+            goto fail;
+        }
+        Py_DECREF(name_obj);
+    }
+    SAM_error error = new_error();
+    state = SAM_table_construct(&error);
+    if (PySAM_has_error(error)){
+        state = NULL;
+        Py_DECREF(names);
+        goto fail;
+    }
+    int copied = PySAM_table_copy_entries(data, state, names);
+    Py_DECREF(names);
+    if (copied < 0)
+        goto fail;
+
+    double idx;
+    error = new_error();
+    if (idx_obj == Py_None)
+        idx = SAM_table_get_num(data, "idx", &error);
+    else{
+        idx = PyFloat_AsDouble(idx_obj);
+        if (PyErr_Occurred()){
+            error_destruct(error);
+            goto fail;
+        }
+    }
+    if (PySAM_has_error(error))
+        goto fail;
+
+    double* costs;
+    PyObject* result = PySAM_new_double_buffer(n_candidates, &costs);
+    if (!result)
+        goto fail;
+
+    const double* energy_use = NULL, *dc_peaks = NULL;
+    int energy_use_rows = 0, energy_use_cols = 0, dc_peaks_rows = 0, dc_peaks_cols = 0;
+    error = new_error();
+    energy_use = SAM_table_get_matrix(state, "ur_energy_use", &energy_use_rows, &energy_use_cols, &error);
+    error_destruct(error);
+    error = new_error();
+    dc_peaks = SAM_table_get_matrix(state, "ur_dc_peaks", &dc_peaks_rows, &dc_peaks_cols, &error);
+    error_destruct(error);
+
+    int i;
+    error = new_error();
+    Py_BEGIN_ALLOW_THREADS
+    for (i = 0; i < n_candidates; i++){
+        SAM_table_set_num(data, "idx", idx, &error);
+        if (PySAM_error_occurred(error))
+            break;
+        SAM_table_set_array(data, "grid_power", &candidates[i * n_steps], n_steps, &error);
+        if (PySAM_error_occurred(error))
+            break;
+        SAM_stateful_module_exec(self_obj->cmod_ptr, data, 0, &error);
+        if (PySAM_error_occurred(error))
+            break;
+        costs[i] = SAM_table_get_num(data, "ur_total_bill", &error);
+        if (PySAM_error_occurred(error))
+            break;
+        Utilityrateforecast_restore_matrix(data, "ur_energy_use", energy_use, energy_use_rows, energy_use_cols, &error);
+        if (PySAM_error_occurred(error))
+            break;
+        Utilityrateforecast_restore_matrix(data, "ur_dc_peaks", dc_peaks, dc_peaks_rows, dc_peaks_cols, &error);
+        if (PySAM_error_occurred(error))
+            break;
+    }
+    Py_END_ALLOW_THREADS
+    if (PySAM_has_error(error)){
+        Py_DECREF(result);
+        goto fail;
+    }
+
+    if (PySAM_table_copy_entries(state, data, NULL) < 0){
+        Py_DECREF(result);
+        goto fail;
+    }
+    SAM_table_destruct(state, NULL);
+    free(candidates);
+    return result;
+
+    fail:
+    if (state){
+        PySAM_table_copy_entries(state, data, NULL);
+        SAM_table_destruct(state, NULL);
+    }
+    free(candidates);
+    return NULL;
+}
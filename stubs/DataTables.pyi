@@ -0,0 +1,42 @@
+# encoding: utf-8
+# module PySAM.DataTables
+""" Access to SAM data tables by name, for PySAM.Hybrids and PySAM.PipelineTools. """
+# no imports
+
+# functions
+
+def get_number(data_ptr, name): # real signature unknown; restored from __doc__
+    """ get_number(data_ptr, name) -> float """
+    return 0.
+
+def set_number(data_ptr, name, value): # real signature unknown; restored from __doc__
+    """ set_number(data_ptr, name, value) -> None """
+    pass
+
+def get_array(data_ptr, name): # real signature unknown; restored from __doc__
+    """ get_array(data_ptr, name) -> tuple """
+    return ()
+
+def set_array(data_ptr, name, value): # real signature unknown; restored from __doc__
+    """ set_array(data_ptr, name, value) -> None """
+    pass
+
+def get_table(data_ptr, name): # real signature unknown; restored from __doc__
+    """ get_table(data_ptr, name) -> Union[int, None] """
+    return 0
+
+def set_table(data_ptr, name, table_ptr): # real signature unknown; restored from __doc__
+    """ set_table(data_ptr, name, table_ptr) -> None """
+    pass
+
+def new_table(data_ptr, name): # real signature unknown; restored from __doc__
+    """ new_table(data_ptr, name) -> int """
+    return 0
+
+def fingerprint(data_ptr, names=None, exclude=None): # real signature unknown; restored from __doc__
+    """ fingerprint(data_ptr, names=None, exclude=None) -> int """
+    return 0
+
+def copy_entries(src_ptr, dst_ptr, exclude=None): # real signature unknown; restored from __doc__
+    """ copy_entries(src_ptr, dst_ptr, exclude=None) -> None """
+    pass
@@ -17,6 +17,15 @@ class BatteryStateful(object):
 	def get_data_ptr(self):
 		pass
 
+	def run_steps(self, args):
+		pass
+
+	def snapshot(self, args):
+		pass
+
+	def restore(self, args):
+		pass
+
 	def __getattribute__(self, *args, **kwargs):
 		pass
 
@@ -232,6 +241,9 @@ def wrap(ssc_data_t) -> BatteryStateful:
 def from_existing(model, config="") -> BatteryStateful:
 	pass
 
+def step_models(models, commands, states, control_mode=1):
+	pass
+
 __loader__ = None 
 
 __spec__ = None
@@ -17,6 +17,9 @@ class Equpartflip(object):
 	def get_data_ptr(self):
 		pass
 
+	def evaluate_scenarios(self, args):
+		pass
+
 	def __getattribute__(self, *args, **kwargs):
 		pass
 
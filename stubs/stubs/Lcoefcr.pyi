@@ -17,6 +17,9 @@ class Lcoefcr(object):
 	def get_data_ptr(self):
 		pass
 
+	def evaluate_arrays(self, args):
+		pass
+
 	def __getattribute__(self, *args, **kwargs):
 		pass
 
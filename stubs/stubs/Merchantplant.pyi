@@ -17,6 +17,12 @@ class Merchantplant(object):
 	def get_data_ptr(self):
 		pass
 
+	def evaluate_scenarios(self, args):
+		pass
+
+	def evaluate_price_paths(self, args):
+		pass
+
 	def __getattribute__(self, *args, **kwargs):
 		pass
 
@@ -17,6 +17,9 @@ class Utilityrateforecast(object):
 	def get_data_ptr(self):
 		pass
 
+	def evaluate_candidates(self, args):
+		pass
+
 	def __getattribute__(self, *args, **kwargs):
 		pass
 
@@ -1,4 +1,5 @@
 import pytest
+import numpy as np
 
 import PySAM.BatteryTools as BatteryTools
 import PySAM.Battery as batt
@@ -188,4 +189,149 @@ def test_liion_sizing_high_tolerence():
     assert (model.BatterySystem.batt_power_discharge_max_kwac == pytest.approx(1.1, 0.1))
     assert (model.BatterySystem.batt_power_charge_max_kwac == pytest.approx(1.1, 0.1))
     assert(model.BatterySystem.batt_current_discharge_max == pytest.approx(4.8, 0.1))
-    assert(model.BatterySystem.batt_current_charge_max == pytest.approx(4.8, 0.1))
\ No newline at end of file
+    assert(model.BatterySystem.batt_current_charge_max == pytest.approx(4.8, 0.1))
+
+def test_batterystateful_fleet():
+    models = []
+    for capacity in (10, 20, 40):
+        model = battstfl.default("NMCGraphite")
+        model.Controls.dt_hr = 1
+        model.ParamsCell.initial_SOC = 50
+        model.Controls.input_power = 0
+        BatteryTools.battery_model_sizing(model, -1, capacity, 500)
+        models.append(model)
+    fleet = BatteryTools.BatteryStatefulFleet(models, workers=2)
+    assert fleet.SOC == pytest.approx([50, 50, 50])
+
+    states = fleet.step([1, 1, 1])
+    assert len(states['SOC']) == 3
+    assert states['SOC'][0] < states['SOC'][1] < states['SOC'][2] < 50
+    assert states['SOC'][1] == pytest.approx(fleet.models[1].StatePack.SOC)
+
+    states = fleet.run([[-1, -1], [-1, -1], [-1, -1]])
+    assert states['P'] == pytest.approx([m.StatePack.P for m in fleet.models])
+    fleet.close()
+
+    # step_models writes the same states as run_steps into the caller's arrays
+    single = battstfl.default("NMCGraphite")
+    single.Controls.dt_hr = 1
+    single.ParamsCell.initial_SOC = 50
+    single.Controls.input_power = 0
+    BatteryTools.battery_model_sizing(single, -1, 10, 500)
+    stepped = battstfl.new()
+    stepped.assign(single.export())
+    single.Controls.control_mode = 1
+    single.setup()
+    stepped.setup()
+    expected = single.run_steps([1, -1, 0.5], 1)
+    states = [np.zeros(1) for _ in BatteryTools.BatteryStatefulFleet.state_names]
+    battstfl.step_models([stepped], np.array([[1, -1, 0.5]]), states, 1)
+    for name, state in zip(BatteryTools.BatteryStatefulFleet.state_names, states):
+        assert state[0] == pytest.approx(expected[name][-1])
+
+
+def test_calculate_battery_sizes():
+    inputs = {'batt_chem': 1, 'batt_Qfull': 2.25, 'batt_Vnom_default': 3.6, 'batt_ac_or_dc': 1,
+              'batt_dc_ac_efficiency': 96, 'batt_dc_dc_efficiency': 99, 'size_by_ac_not_dc': True,
+              'desired_voltage': 500}
+    powers = [50, 100, 200]
+    capacities = [200, 400, 800]
+    sizes = BatteryTools.calculate_battery_sizes(dict(inputs, desired_power=powers, desired_capacity=capacities))
+    assert sizes['feasible'].all()
+
+    for i in range(3):
+        expected = BatteryTools.calculate_battery_size(dict(inputs, desired_power=powers[i], desired_capacity=capacities[i]))
+        for k, v in expected.items():
+            assert sizes[k][i] == pytest.approx(v)
+
+    model = batt.default("GenericBatteryCommercial")
+    BatteryTools.apply_battery_size(model, sizes, 1)
+    assert model.BatterySystem.batt_computed_bank_capacity == pytest.approx(sizes['batt_computed_bank_capacity'][1])
+    assert model.BatterySystem.batt_computed_strings == sizes['batt_computed_strings'][1]
+
+    # scalar inputs give 0-d arrays
+    single = BatteryTools.calculate_battery_sizes(dict(inputs, desired_power=powers[0], desired_capacity=capacities[0]))
+    BatteryTools.apply_battery_size(model, single)
+    assert model.BatterySystem.batt_computed_bank_capacity == pytest.approx(float(single['batt_computed_bank_capacity']))
+
+
+def test_compare_dispatch_strategies():
+    import PySAM.Utilityrate5 as ur
+
+    model = batt.default("GenericBatteryCommercial")
+    rate = ur.default("GenericBatteryCommercial")
+    strategies = [{'batt_dispatch_choice': 0}, {'batt_dispatch_choice': 0, 'batt_look_ahead_hours': 12}]
+
+    table = BatteryTools.compare_dispatch_strategies(model, strategies, utility_inputs=rate.export())
+    assert len(table) == 2
+    assert list(table['batt_dispatch_choice']) == [0, 0]
+    assert (table['cycles'] > 0).all()
+
+    model.value('batt_dispatch_choice', 0)
+    model.execute(0)
+    assert table['cycles'][0] == pytest.approx(max(model.Outputs.batt_cycles))
+
+
+def test_batterystateful_lifetime():
+    model = battstfl.default("NMCGraphite")
+    model.Controls.dt_hr = 1
+    model.ParamsCell.initial_SOC = 50
+    model.Controls.input_power = 0
+    model.ParamsCell.life_model = 1
+    year_power = ([10] * 4 + [0] * 8 + [-10] * 4 + [0] * 8) * 365
+
+    lifetime = BatteryTools.BatteryStatefulLifetime(model, year_power)
+    base = lifetime.run(2)
+    assert lifetime.years_simulated == 2
+    assert base['capacity_percent'][1] < base['capacity_percent'][0] < 100
+
+    extended = lifetime.run(3)
+    assert lifetime.years_simulated == 3
+    assert list(extended['capacity_percent'][:2]) == pytest.approx(list(base['capacity_percent']))
+    assert extended['capacity_percent'][2] < extended['capacity_percent'][1]
+
+
+def test_batterystateful_lifetime_replacements():
+    def new_model():
+        model = battstfl.default("NMCGraphite")
+        model.Controls.dt_hr = 1
+        model.ParamsCell.initial_SOC = 50
+        model.Controls.input_power = 0
+        model.ParamsCell.life_model = 1
+        model.ParamsPack.replacement_option = 2
+        model.ParamsPack.replacement_schedule_percent = [0, 0, 0]
+        return model
+    year_power = ([10] * 4 + [0] * 8 + [-10] * 4 + [0] * 8) * 365
+
+    lifetime = BatteryTools.BatteryStatefulLifetime(new_model(), year_power)
+    lifetime.run(3, [0, 100, 0])
+    assert lifetime.years_simulated == 3
+
+    # resumes from the end of the first year, the last year the two schedules have in common
+    replaced = lifetime.run(3, [0, 0, 100])
+    assert lifetime.years_simulated == 5
+
+    fresh = BatteryTools.BatteryStatefulLifetime(new_model(), year_power).run(3, [0, 0, 100])
+    for name in ('capacity_percent', 'n_cycles', 'n_replacements', 'SOC'):
+        assert list(replaced[name]) == pytest.approx(list(fresh[name]))
+
+
+def test_degradation_surrogate():
+    model = battstfl.default("NMCGraphite")
+    model.Controls.dt_hr = 1
+    model.Controls.input_power = 0
+    model.ParamsCell.life_model = 1
+
+    surrogate = BatteryTools.fit_degradation_surrogate(model, dods=(50, 80, 100), temperatures=(25,), days=60,
+                                                       validation_runs=1)
+    assert surrogate.fit_error >= 0
+    assert surrogate.error_bound >= surrogate.validation_error > 0
+    assert surrogate.in_domain(60, [50, 100], 25)
+    assert not surrogate.in_domain(61, 80, 25)
+    assert not surrogate.in_domain(30, 40, 25)
+    capacity = surrogate.capacity_percent([30, 60], 80, 25)
+    assert capacity[1] < capacity[0] < 100
+
+    run = BatteryTools._degradation_worker(({k: v for k, v in model.export().items()
+                                             if k in ('Controls', 'ParamsCell', 'ParamsPack')}, 65, 25, 60))
+    assert surrogate.capacity_percent(60, 65, 25) == pytest.approx(run[-1], abs=surrogate.error_bound + 0.5)
@@ -0,0 +1,36 @@
+import pytest
+import numpy as np
+
+import PySAM.GenericSystem as gensys
+import PySAM.Grid as grid
+import PySAM.Merchantplant as mp
+from PySAM.FinancialTools import evaluate_price_paths
+
+
+def test_evaluate_price_paths():
+    sys_model = gensys.default("GenericSystemMerchantPlant")
+    grid_model = grid.from_existing(sys_model, "GenericSystemMerchantPlant")
+    fin_model = mp.from_existing(sys_model, "GenericSystemMerchantPlant")
+    sys_model.execute()
+    grid_model.execute()
+
+    fin_model.Revenue.mp_enable_energy_market_revenue = 1
+    fin_model.Revenue.mp_enable_market_percent_gen = 0
+    with pytest.raises(ValueError):
+        fin_model.evaluate_price_paths(np.ones((2, 8760)), ['project_return_aftertax_npv'])
+    fin_model.Revenue.mp_enable_market_percent_gen = 1
+    base_prices = np.array(fin_model.Revenue.mp_energy_market_revenue_single)[:, 0]
+    prices = np.outer([0.5, 1.0, 1.5, 2.0], base_prices)
+
+    results = evaluate_price_paths(fin_model, prices, workers=2)
+    npv = results['project_return_aftertax_npv']
+    assert len(npv) == 4
+    assert np.all(np.diff(npv) > 0)
+    assert np.array(fin_model.Revenue.mp_energy_market_revenue_single)[:, 0] == pytest.approx(base_prices)
+
+    serial = evaluate_price_paths(fin_model, prices, workers=1)
+    assert serial['project_return_aftertax_npv'] == pytest.approx(npv)
+
+    fin_model.Revenue.mp_energy_market_revenue_single = [[p] for p in prices[2]]
+    fin_model.execute()
+    assert fin_model.Outputs.project_return_aftertax_npv == pytest.approx(npv[2])
@@ -0,0 +1,70 @@
+import pytest
+
+import PySAM.Lcoefcr as lcoefcr
+import PySAM.IphToLcoefcr as iph_to_lcoefcr
+import PySAM.LcoefcrDesign as lcoefcr_design
+
+
+def test_evaluate_arrays():
+    model = lcoefcr.new()
+    model.SimpleLCOE.assign({'annual_energy': 1e6, 'capital_cost': 2e6, 'fixed_charge_rate': 0.1,
+                             'fixed_operating_cost': 3e4, 'variable_operating_cost': 0.01})
+
+    annual_energy = [5e5, 1e6, 2e6]
+    lcoe = list(model.evaluate_arrays(annual_energy=annual_energy, capital_cost=[1e6, 2e6, 3e6]))
+    assert len(lcoe) == 3
+
+    for i, aep in enumerate(annual_energy):
+        model.SimpleLCOE.annual_energy = aep
+        model.SimpleLCOE.capital_cost = (i + 1) * 1e6
+        model.execute()
+        assert lcoe[i] == pytest.approx(model.Outputs.lcoe_fcr)
+
+    # unassigned arguments use the model's values
+    assert list(model.evaluate_arrays()) == pytest.approx([model.Outputs.lcoe_fcr])
+
+    with pytest.raises(ValueError):
+        model.evaluate_arrays(annual_energy=[1, 2], capital_cost=[1, 2, 3])
+
+
+def test_iph_evaluate_arrays():
+    model = iph_to_lcoefcr.new()
+    model.SimpleLCOE.fixed_operating_cost = 1000
+    model.IPHLCOH.electricity_rate = 0.1
+    cost = model.evaluate_arrays(annual_electricity_consumption=[0, 1e4])
+    assert list(cost) == pytest.approx([1000, 2000])
+    assert model.SimpleLCOE.fixed_operating_cost == 1000
+
+
+def test_design_evaluate_arrays():
+    model = lcoefcr_design.new()
+    model.SystemControl.sim_type = 1
+    model.SimpleLCOE.assign({'annual_energy': 1e6, 'fixed_operating_cost': 3e4, 'variable_operating_cost': 0.01,
+                             'ui_fcr_input_option': 0, 'ui_fixed_charge_rate': 0.1})
+    model.SystemCosts.total_installed_cost = 2e6
+    model.IPHLCOH.assign({'electricity_rate': 0.05, 'annual_electricity_consumption': 1e4})
+
+    def compare(annual_energy, total_installed_cost):
+        lcoe = list(model.evaluate_arrays(annual_energy=annual_energy, total_installed_cost=total_installed_cost))
+        assert len(lcoe) == len(annual_energy)
+        for i, aep in enumerate(annual_energy):
+            model.SimpleLCOE.annual_energy = aep
+            model.SystemCosts.total_installed_cost = total_installed_cost[i]
+            model.execute()
+            assert lcoe[i] == pytest.approx(model.Outputs.lcoe_fcr)
+
+    compare([5e5, 1e6, 2e6], [1e6, 2e6, 3e6])
+
+    # the calculated fixed charge rate comes from a design run, which leaves sim_type as it was
+    model.SimpleLCOE.assign({'ui_fcr_input_option': 1, 'c_construction_cost': [100], 'c_construction_interest': 8,
+                             'c_debt_percent': 50, 'c_depreciation_schedule': [20, 32, 19.2, 11.52, 11.52, 5.76],
+                             'c_equity_return': 10, 'c_inflation': 2.5, 'c_lifetime': 25,
+                             'c_nominal_interest_rate': 6, 'c_tax_rate': 25})
+    compare([5e5, 1e6, 2e6], [1e6, 2e6, 3e6])
+    assert model.SystemControl.sim_type == 1
+    assert model.Outputs.fixed_charge_rate_calc > 0
+
+    model.unassign('sim_type')
+    model.evaluate_arrays()
+    with pytest.raises(Exception):
+        model.value('sim_type')
@@ -1,6 +1,6 @@
 import pytest
 
-from PySAM.LoadTools import get_monthly_peaks
+from PySAM.LoadTools import get_monthly_peaks, resample_timeseries, resample_to_monthly
 
 def test_monthly_load_hourly():
     steps_per_hour = 1
@@ -19,3 +19,54 @@ def test_monthly_load_hourly():
     assert(peaks[7] == 300)
     assert(peaks[8] == 100)
 
+
+
+def test_monthly_load_subhourly():
+    steps_per_hour = 4
+    load = [100] * 8760 * steps_per_hour
+    load[5830 * steps_per_hour + 3] = 300
+
+    peaks = get_monthly_peaks(load, steps_per_hour)
+
+    assert(len(peaks) == 12)
+    assert(peaks[6] == 100)
+    assert(peaks[7] == 300)
+
+
+def test_monthly_load_multiple_years():
+    load = [100] * 8760 * 2
+    load[8760 + 5830] = 300
+
+    peaks = get_monthly_peaks(load, 1)
+
+    assert(len(peaks) == 12)
+    assert(type(peaks[0]) == float)
+    assert(peaks[7] == 300)
+
+
+def test_resample_timeseries():
+    gen_5min = [float(i % 12) for i in range(8760 * 12)]
+
+    hourly_mean = resample_timeseries(gen_5min, 12, 1, 'mean')
+    assert(len(hourly_mean) == 8760)
+    assert(hourly_mean[0] == pytest.approx(5.5))
+
+    hourly_sum = resample_timeseries(gen_5min, 12, 1, 'sum')
+    assert(hourly_sum[10] == pytest.approx(66))
+    assert(resample_timeseries(gen_5min, 12, 1, 'max')[0] == 11)
+    assert(resample_timeseries(gen_5min, 12, 1, 'instantaneous')[0] == 0)
+
+    quarter_hourly = resample_timeseries(hourly_sum, 1, 4, 'sum')
+    assert(len(quarter_hourly) == 8760 * 4)
+    assert(quarter_hourly[0] == pytest.approx(16.5))
+
+
+def test_resample_to_monthly_leap_and_lifetime():
+    leap = [1.0] * 8784
+    monthly = resample_to_monthly(leap, 1, 'sum')
+    assert(monthly[1] == 29 * 24)
+
+    lifetime = [1.0] * 8760 * 2 * 2
+    monthly = resample_to_monthly(lifetime, 2, 'mean')
+    assert(len(monthly) == 24)
+    assert(monthly[13] == pytest.approx(1))
@@ -0,0 +1,100 @@
+import os
+import shutil
+
+import pytest
+from pathlib import Path
+
+import PySAM.Pvwattsv8 as pv
+import PySAM.Battwatts as bt
+import PySAM.Utilityrate5 as ur
+import PySAM.Cashloan as loan
+from PySAM.PipelineTools import Pipeline, ResultCache, cmod_name
+
+
+solar_resource = str(Path(__file__).parent / "blythe_ca_33.617773_-114.588261_psmv3_60_tmy.csv")
+
+
+def test_cmod_name():
+    assert cmod_name(pv.new()) == "pvwattsv8"
+    assert cmod_name(ur.new()) == "utilityrate5"
+    import PySAM.GenericSystem as gensys
+    assert cmod_name(gensys.new()) == "generic_system"
+
+
+def test_pipeline_skips_unchanged_stages():
+    pv_model = pv.default("PVWattsBatteryCommercial")
+    pv_model.SolarResource.solar_resource_file = solar_resource
+    batt_model = bt.from_existing(pv_model, "PVWattsBatteryCommercial")
+    ur_model = ur.from_existing(pv_model, "PVWattsBatteryCommercial")
+    fin_model = loan.from_existing(pv_model, "PVWattsBatteryCommercial")
+
+    pipeline = Pipeline([pv_model, batt_model, ur_model, fin_model])
+    assert pipeline.execute() == ["pvwattsv8", "battwatts", "utilityrate5", "cashloan"]
+    npv = fin_model.Outputs.npv
+    gen = batt_model.Outputs.gen
+
+    assert pipeline.execute() == []
+
+    tou_mat = [list(row) for row in ur_model.ElectricityRates.ur_ec_tou_mat]
+    for row in tou_mat:
+        row[4] *= 2
+    ur_model.ElectricityRates.ur_ec_tou_mat = tou_mat
+    assert pipeline.execute() == ["utilityrate5", "cashloan"]
+    assert fin_model.Outputs.npv != pytest.approx(npv)
+
+    # Battwatts runs again from the PV generation, not from its own results
+    pipeline.invalidate("battwatts")
+    assert pipeline.execute() == ["battwatts", "utilityrate5", "cashloan"]
+    assert batt_model.Outputs.gen == pytest.approx(gen)
+
+
+def test_pipeline_detects_changed_overwritten_inputs():
+    pv_model = pv.default("PVWattsBatteryCommercial")
+    pv_model.SolarResource.solar_resource_file = solar_resource
+    pv_model.execute()
+    batt_model = bt.from_existing(pv_model, "PVWattsBatteryCommercial")
+    ur_model = ur.from_existing(pv_model, "PVWattsBatteryCommercial")
+    fin_model = loan.from_existing(pv_model, "PVWattsBatteryCommercial")
+
+    # gen is an input of Battwatts that only Battwatts computes in this pipeline
+    pipeline = Pipeline([batt_model, ur_model, fin_model])
+    assert pipeline.execute() == ["battwatts", "utilityrate5", "cashloan"]
+    assert pipeline.execute() == []
+
+    ur_model.SystemOutput.gen = [x / 2 for x in pv_model.Outputs.gen]
+    assert pipeline.execute() == ["battwatts", "utilityrate5", "cashloan"]
+    assert pipeline.execute() == []
+
+
+def test_result_cache(tmp_path):
+    cache = ResultCache(str(tmp_path))
+
+    model = pv.default("PVWattsBatteryCommercial")
+    model.SolarResource.solar_resource_file = solar_resource
+    assert not cache.execute(model)
+    annual_energy = model.Outputs.annual_energy
+
+    # same inputs in a new model restore the results without simulating
+    model = pv.default("PVWattsBatteryCommercial")
+    model.SolarResource.solar_resource_file = solar_resource
+    assert cache.execute(model)
+    assert model.Outputs.annual_energy == pytest.approx(annual_energy)
+    assert len(model.Outputs.gen) == 8760
+    assert (cache.hits, cache.misses) == (1, 1)
+
+    model.SystemDesign.system_capacity *= 2
+    assert not cache.execute(model)
+    assert model.Outputs.annual_energy == pytest.approx(annual_energy * 2, rel=0.05)
+
+    cache.clear()
+    assert not cache.execute(model)
+
+    # a weather file replaced in place isn't a hit for the results of the old file
+    weather_file = tmp_path / "weather.csv"
+    shutil.copyfile(solar_resource, weather_file)
+    model.SolarResource.solar_resource_file = str(weather_file)
+    assert not cache.execute(model)
+    assert cache.execute(model)
+    stat = os.stat(weather_file)
+    os.utime(weather_file, ns=(stat.st_atime_ns, stat.st_mtime_ns + 10 ** 9))
+    assert not cache.execute(model)
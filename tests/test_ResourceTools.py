@@ -204,3 +204,73 @@ def test_resourcefilefetcher():
         assert wtk_csv.line_num == 8761 + 1
 
     shutil.rmtree(resource_dir)
+
+
+def test_convert_weather_files(tmp_path):
+    solar = [str(Path(__file__).parent / "blythe_ca_33.617773_-114.588261_psmv3_60_tmy.csv"),
+             str(Path(__file__).parent / "phoenix_az_33.450495_-111.983688_psmv3_60_tmy.csv")]
+    stats = tools.convert_weather_files(solar, str(tmp_path), workers=2, packed=True, verbose=False)
+
+    assert stats['n_files'] == 2
+    assert len(stats['failed']) == 0
+    csv_file, npz_file = stats['files'][solar[0]]
+    data = tools.SAM_CSV_to_solar_data(csv_file)
+    assert len(data['gh']) == 8760
+    assert data['lat'] == pytest.approx(33.61, 1e-2)
+
+    import numpy as np
+    packed = np.load(npz_file)
+    assert packed['gh'] == pytest.approx(data['gh'], 1e-3)
+    assert packed['header'][0] == pytest.approx(data['lat'])
+
+    # a file with the same name in another folder is reported, not written over the first
+    other_dir = tmp_path / "other"
+    other_dir.mkdir()
+    same_name = str(other_dir / os.path.basename(solar[0]))
+    shutil.copy(solar[1], same_name)
+    stats = tools.convert_weather_files([solar[0], same_name], str(tmp_path / "out"), verbose=False)
+    assert stats['n_files'] == 1
+    assert same_name in stats['failed']
+    assert tools.SAM_CSV_to_solar_data(stats['files'][solar[0]])['lat'] == pytest.approx(33.61, 1e-2)
+
+
+def test_read_marine_resource_files():
+    import PySAM.MhkWave as mhk
+    wave = str(Path(__file__).parent / "CalWave_California_Wave Resource _SAM CSV.csv")
+    resource = tools.read_marine_resource_files([wave, wave], 'wave', 0, workers=2)
+
+    assert len(resource) == 2
+    assert resource.columns['wave_resource_matrix'].shape[0] == 2
+    assert resource.metadata[0]['lat'] == resource.metadata[1]['lat']
+
+    model = mhk.default("MEwaveLCOECalculator")
+    resource.assign(model, 1)
+    assert model.MHKWave.wave_resource_model_choice == 0
+    assert len(model.MHKWave.wave_resource_matrix) == resource.columns['wave_resource_matrix'].shape[1]
+
+    # MhkTidal's joint probability distribution input, tidal_resource, isn't an output of TidalFileReader
+    with pytest.raises(ValueError):
+        tools.read_marine_resource_files([wave], 'tidal', 0)
+
+
+def test_validate_weather_files(tmp_path):
+    solar = str(Path(__file__).parent / "blythe_ca_33.617773_-114.588261_psmv3_60_tmy.csv")
+    bad = str(tmp_path / "truncated.csv")
+    with open(solar) as f_in, open(bad, 'w') as f_out:
+        f_out.writelines(f_in.readlines()[:1000])
+
+    cache_file = str(tmp_path / "wfcheck_cache.json")
+    results = tools.validate_weather_files([solar, bad], workers=2, cache_file=cache_file, verbose=False)
+    assert results[os.path.abspath(solar)][0]
+    assert not results[os.path.abspath(bad)][0]
+
+    with open(cache_file) as f:
+        cache = json.load(f)
+    assert len(cache) == 2
+
+    assert tools.validate_weather_files([solar, bad], cache_file=cache_file, verbose=False) == results
+
+    missing = str(tmp_path / "missing.csv")
+    results = tools.validate_weather_files([missing, solar], cache_file=cache_file, verbose=False)
+    assert not results[os.path.abspath(missing)][0]
+    assert results[os.path.abspath(solar)][0]
@@ -0,0 +1,37 @@
+import pytest
+from pathlib import Path
+
+import PySAM.Pvwattsv8 as pv
+import PySAM.Grid as grid
+import PySAM.Singleowner as so
+
+
+solar_resource = str(Path(__file__).parent / "blythe_ca_33.617773_-114.588261_psmv3_60_tmy.csv")
+
+
+def test_evaluate_scenarios():
+    pv_model = pv.default("PVWattsSingleOwner")
+    pv_model.SolarResource.solar_resource_file = solar_resource
+    grid_model = grid.from_existing(pv_model, "PVWattsSingleOwner")
+    fin_model = so.from_existing(pv_model, "PVWattsSingleOwner")
+    pv_model.execute()
+    grid_model.execute()
+
+    ppa_price = fin_model.PPAPrice.ppa_price_input
+    fin_model.execute()
+    outputs = fin_model.Outputs.export()
+    prices = [0.04, 0.06, 0.08]
+    results = fin_model.evaluate_scenarios({'ppa_price_input': prices}, ['project_return_aftertax_npv', 'lcoe_real'])
+    npvs = list(results['project_return_aftertax_npv'])
+    assert len(npvs) == 3
+    assert npvs[0] < npvs[1] < npvs[2]
+    assert fin_model.PPAPrice.ppa_price_input == ppa_price
+    assert fin_model.Outputs.export() == outputs
+
+    fin_model.PPAPrice.ppa_price_input = (prices[1],)
+    fin_model.execute()
+    assert fin_model.Outputs.project_return_aftertax_npv == pytest.approx(npvs[1])
+    assert fin_model.Outputs.lcoe_real == pytest.approx(results['lcoe_real'][1])
+
+    with pytest.raises(ValueError):
+        fin_model.evaluate_scenarios({'ppa_price_input': prices, 'total_installed_cost': [1e6]}, ['lcoe_real'])
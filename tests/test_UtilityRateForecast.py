@@ -79,3 +79,25 @@ def test_multiple_execute_calls(setup_rate):
         idx += 1
 
     assert(total_cost == pytest.approx(1603.08, 0.01)) # Equivalent to "ur_total_bill" in test_bill_equivalence
+
+def test_evaluate_candidates(setup_rate):
+    sample_load = str(Path(__file__).parent / "sample_load.csv")
+    df = pd.read_csv(sample_load, dtype=float)
+    load = pd.to_numeric(df.iloc[:, 0]).values
+
+    setup_rate.value("gen", [0] * 8760)
+    setup_rate.value("load", load)
+    setup_rate.value("idx", 0)
+    setup_rate.value("grid_power", [-1.0 * p for p in load[0:24]])
+    setup_rate.setup()
+
+    candidates = np.array([-1.0 * load[0:24], -0.5 * load[0:24], -2.0 * load[0:24]])
+    costs = np.asarray(setup_rate.evaluate_candidates(candidates))
+    assert len(costs) == 3
+    assert costs[1] < costs[0] < costs[2]
+
+    assert np.asarray(setup_rate.evaluate_candidates(candidates)) == pytest.approx(costs)
+
+    setup_rate.value("grid_power", candidates[0])
+    setup_rate.execute()
+    assert setup_rate.Outputs.ur_total_bill == pytest.approx(costs[0])
@@ -1,6 +1,9 @@
 from pathlib import Path
 import json
 
+import numpy as np
+import pytest
+
 import PySAM.UtilityRateTools as tools 
 
 def test_urdb():
@@ -75,4 +78,74 @@ def test_dc_flat_mat():
     flat_demand = ur5["ur_dc_flat_mat"]
 
     assert(len(flat_demand) == 24) # 12 months, 2 tiers per month
-    assert(flat_demand[0][2] == 100) # Tier max in kW
\ No newline at end of file
+    assert(flat_demand[0][2] == 100) # Tier max in kW
+
+def test_rates_cache(tmp_path):
+    urdb = str(Path(__file__).parent / "urdb_rate_539f6a23ec4f024411ec8beb.json")
+    with open(urdb, 'r') as file:
+        urdb_data = json.loads(json.load(file))['items'][0]
+    weekday_schedule = [list(month) for month in urdb_data['energyweekdayschedule']]
+
+    cache = tools.ElectricityRatesCache(tmp_path)
+    rates = cache.compile(urdb_data)
+    assert urdb_data['energyweekdayschedule'] == weekday_schedule
+    assert rates['ur_ec_sched_weekday'][0][0] == weekday_schedule[0][0] + 1
+
+    # new cache instance reads from disk
+    reloaded = tools.ElectricityRatesCache(tmp_path).get(urdb_data['label'])
+    assert reloaded['ur_ec_sched_weekday'] == rates['ur_ec_sched_weekday']
+    assert [list(r) for r in reloaded['ur_dc_flat_mat']] == [list(r) for r in rates['ur_dc_flat_mat']]
+
+    # changed response with the same label is recompiled
+    urdb_data['fixedchargefirstmeter'] = 1000
+    urdb_data['fixedchargeunits'] = "$/month"
+    assert cache.compile(urdb_data)['ur_monthly_fixed_charge'] == 1000
+
+
+def test_portfolio_bills():
+    urdb = str(Path(__file__).parent / "urdbv7.json")
+    with open(urdb, 'r') as file:
+        urdb_data = json.load(file)
+    rates = tools.URDBv8_to_ElectricityRates(urdb_data)
+
+    load = np.loadtxt(Path(__file__).parent / "sample_load.csv", skiprows=1)
+    loads = np.array([load, load * 2, load * 0.5])
+    gen = np.zeros_like(loads)
+    gen[2] = load * 0.25
+
+    bills = tools.calculate_portfolio_bills(rates, loads, gen)
+    assert bills['monthly_bill_w_sys'].shape == (3, 12)
+    assert bills['annual_bill_wo_sys'][1] > bills['annual_bill_wo_sys'][0] > bills['annual_bill_wo_sys'][2]
+    assert bills['annual_bill_w_sys'][0] == pytest.approx(bills['annual_bill_wo_sys'][0])
+    assert bills['annual_bill_w_sys'][2] < bills['annual_bill_wo_sys'][2]
+
+    parallel = tools.calculate_portfolio_bills(rates, loads, gen, workers=2, chunk_size=2)
+    assert parallel['monthly_bill_w_sys'] == pytest.approx(bills['monthly_bill_w_sys'])
+
+
+def test_compare_tariffs():
+    urdb = str(Path(__file__).parent / "urdbv7.json")
+    with open(urdb, 'r') as file:
+        urdb_data = json.load(file)
+    rates = tools.URDBv8_to_ElectricityRates(urdb_data)
+    rates_no_demand = dict(rates, ur_dc_enable=0)
+
+    load = np.loadtxt(Path(__file__).parent / "sample_load.csv", skiprows=1)
+    portfolio = tools.calculate_portfolio_bills(rates, [load])
+
+    cache = dict()
+    bills = tools.compare_tariffs([rates, rates_no_demand], load, cache=cache)
+    assert bills['annual_bill_w_sys'][0] == pytest.approx(portfolio['annual_bill_w_sys'][0])
+    assert bills['annual_bill_w_sys'][1] < bills['annual_bill_w_sys'][0]
+    assert len(cache) == 2
+
+    again = tools.compare_tariffs([rates_no_demand, rates], load, cache=cache)
+    assert len(cache) == 2
+    assert again['annual_bill_w_sys'] == pytest.approx(bills['annual_bill_w_sys'][::-1])
+
+    # long arrays that print the same still key differently
+    sell = np.zeros(8760)
+    sell_changed = sell.copy()
+    sell_changed[4000] = 0.1
+    assert tools._inputs_digest({'ur_ts_sell_rate': sell}) != tools._inputs_digest({'ur_ts_sell_rate': sell_changed})
+    assert tools._inputs_digest({'ur_ts_sell_rate': sell}) == tools._inputs_digest({'ur_ts_sell_rate': list(sell)})
@@ -119,3 +119,112 @@ def test_GenericPVWattsWindFuelCellBatteryHybrid_SingleOwner():
     assert windannualenergy == pytest.approx(366975552, 1e-2)
     assert battannualenergy == pytest.approx(1331720000, 1e-2)
     assert npv == pytest.approx(-1748593536, 1e-2)
+
+
+def test_hybrid_execute_reuses_subsystem_data():
+    m = HybridSystem([pvsam, wind, batt], 'singleowner')
+    m.default("PhotovoltaicWindBatteryHybridSingleOwner")
+    m.pv.SolarResource.solar_resource_file = str(solar_resource_path)
+    m.wind.Resource.wind_resource_filename = str(wind_resource_path)
+    m.execute()
+    npv = m.singleowner.Outputs.project_return_aftertax_npv
+
+    # sub-systems with unchanged inputs stay in the hybrid data and aren't copied again, even after reading results
+    pv_data = m.pv._hybrid_data_ptr
+    assert pv_data is not None
+    assert m.pv.Outputs.annual_energy > 0
+    m.singleowner.value('ppa_price_input', [x * 1.1 for x in m.singleowner.value('ppa_price_input')])
+    m.execute()
+    assert m.pv._hybrid_data_ptr == pv_data
+    assert m.singleowner.Outputs.project_return_aftertax_npv > npv
+
+    # a change made through a variable group held from before is detected by the data fingerprint, and results read
+    # through a variable group held from before are those of the latest execute
+    turbine = m.wind.Turbine
+    wind_outputs = m.wind.Outputs
+    wind_energy = wind_outputs.annual_energy
+    turbine.wind_turbine_powercurve_powerout = [x / 2 for x in turbine.wind_turbine_powercurve_powerout]
+    m.execute()
+    assert wind_outputs.annual_energy < wind_energy
+    assert wind_outputs.annual_energy == m.wind.Outputs.annual_energy
+
+
+def test_execute_hybrid_systems():
+    from PySAM.Hybrids.HybridSystem import execute_hybrid_systems
+
+    systems = []
+    for ppa_scale in (1.0, 1.2):
+        m = HybridSystem([pv, wind, batt], 'singleowner')
+        m.default("PVWattsWindBatteryHybridSingleOwner")
+        m.pvwatts.SolarResource.solar_resource_file = str(solar_resource_path)
+        m.wind.Resource.wind_resource_filename = str(wind_resource_path)
+        m.singleowner.value('ppa_price_input', [x * ppa_scale for x in m.singleowner.value('ppa_price_input')])
+        systems.append(m)
+
+    errors = execute_hybrid_systems(systems, workers=2)
+    assert errors == [None, None]
+    npvs = [m.singleowner.Outputs.project_return_aftertax_npv for m in systems]
+    assert npvs[1] > npvs[0]
+
+    systems[0].execute()
+    assert systems[0].singleowner.Outputs.project_return_aftertax_npv == pytest.approx(npvs[0])
+
+
+def test_hybrid_generator_tables():
+    m = HybridSystem([pv, wind, batt], 'singleowner')
+    m.default("PVWattsWindBatteryHybridSingleOwner")
+
+    m.pvwatts.om_fixed = 10
+    assert m.pvwatts.om_fixed == (10,)
+    m.pvwatts.om_capacity = [1, 2]
+    assert m.pvwatts.om_capacity == (1, 2)
+    assert m.pvwatts.om_fixed == (10,)
+    m.wind.total_installed_cost = 1e6
+    assert m.wind.total_installed_cost == 1e6
+
+    m = HybridSystem([pv, fuelcell, batt], 'singleowner')
+    m.default("PVWattsWindFuelCellBatteryHybridSingleOwner")
+    m.fuelcell.om_fixed = 5
+    m.fuelcell.om_capacity = [3, 4]
+    assert m.fuelcell.om_capacity == (3, 4)
+    assert m.fuelcell.om_fixed == (5,)
+
+
+def test_hybrid_sweep():
+    from PySAM.Hybrids import HybridSweep
+
+    m = HybridSystem([pv, wind, batt], 'singleowner')
+    m.default("PVWattsWindBatteryHybridSingleOwner")
+    m.pvwatts.SolarResource.solar_resource_file = str(solar_resource_path)
+    m.wind.Resource.wind_resource_filename = str(wind_resource_path)
+    ppa = m.singleowner.value('ppa_price_input')
+
+    calls = []
+
+    def npv(system):
+        calls.append(1)
+        return system.singleowner.Outputs.project_return_aftertax_npv
+
+    sweep = HybridSweep(m, workers=2, outputs=npv)
+    cases = [{'hybrid': {'ppa_price_input': [x * scale for x in ppa]}} for scale in (1.0, 1.2)]
+    npvs = sweep.run(cases)
+    assert npvs[1] > npvs[0]
+    assert len(calls) == 2
+
+    # repeated cases are not run again
+    assert sweep.run(cases + cases[:1]) == npvs + npvs[:1]
+    assert len(calls) == 2
+
+    m.execute()
+    assert m.singleowner.Outputs.project_return_aftertax_npv == pytest.approx(npvs[0])
+
+    # battery cases after the first run with a GenericSystem in place of the simulated wind generator
+    cases = [{'battery': {'batt_computed_bank_capacity': kwh}} for kwh in (1000, 2000, 4000)]
+    reused = HybridSweep(m, outputs=npv).run(cases)
+    simulated = HybridSweep(m, outputs=npv, reuse_generators=False).run(cases)
+    assert reused == pytest.approx(simulated, rel=1e-4)
+
+    # with several copies, which cases reuse a profile doesn't depend on thread timing, so results repeat exactly
+    cases = cases + [{'battery': {'batt_computed_bank_capacity': kwh}} for kwh in (1500, 3000, 6000)]
+    runs = [HybridSweep(m, workers=3, outputs=npv).run(cases) for _ in range(3)]
+    assert runs[0] == runs[1] == runs[2]
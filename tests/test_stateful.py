@@ -83,3 +83,57 @@ def test_stateful_from_data():
     b.assign(d)
     b.setup()
     assert b.Controls.control_mode == 1
+
+
+def test_stateful_run_steps():
+    b = bt.default("NMCGraphite")
+    b.Controls.control_mode = 1
+    b.Controls.dt_hr = 1
+    b.ParamsCell.minimum_SOC = 10
+    b.ParamsCell.maximum_SOC = 90
+    b.ParamsCell.initial_SOC = 50
+    b.Controls.input_power = 0
+    b.setup()
+
+    power = [0.5, -0.5] * 12
+    results = b.run_steps(power)
+    assert len(results['SOC']) == len(power)
+    assert results['SOC'][0] == approx(44.811, 1e-2)
+    assert results['SOC'][-1] == approx(b.StatePack.SOC)
+    assert results['P'][-1] == approx(b.StatePack.P)
+
+    b_single = bt.default("NMCGraphite")
+    b_single.Controls.control_mode = 1
+    b_single.Controls.dt_hr = 1
+    b_single.ParamsCell.minimum_SOC = 10
+    b_single.ParamsCell.maximum_SOC = 90
+    b_single.ParamsCell.initial_SOC = 50
+    b_single.Controls.input_power = 0
+    b_single.setup()
+    for i, p in enumerate(power):
+        b_single.Controls.input_power = p
+        b_single.execute(0)
+        assert results['SOC'][i] == approx(b_single.StatePack.SOC)
+
+
+def test_stateful_snapshot_restore():
+    b = bt.default("NMCGraphite")
+    b.Controls.control_mode = 1
+    b.Controls.dt_hr = 1
+    b.ParamsCell.initial_SOC = 50
+    b.Controls.input_power = 0
+    b.setup()
+    b.run_steps([0.5, -0.5, 0.5])
+
+    handle = b.snapshot()
+    state = b.export()['StateCell']
+    first = b.run_steps([0.5] * 5)
+
+    b.restore(handle)
+    assert b.export()['StateCell'] == state
+    second = b.run_steps([0.5] * 5)
+    assert list(first['SOC']) == approx(list(second['SOC']))
+
+    b.restore(handle)
+    charge = b.run_steps([-0.5] * 5)
+    assert charge['SOC'][-1] > first['SOC'][-1]